@@ -0,0 +1,23 @@
+#include "acceptance_filter.hpp"
+
+void CAN::Acceptance_filter::Module(Codes::Module module){
+    module_mask = {};
+    for (auto accepted : {Codes::Module::All, Codes::Module::Any, module}) {
+        uint32_t code = static_cast<uint32_t>(accepted) & 0xff;
+        module_mask[code >> 5] |= (1UL << (code & 0x1f));
+    }
+    enabled = true;
+}
+
+void CAN::Acceptance_filter::Instance(Codes::Instance instance){
+    instance_mask = (1U << (static_cast<uint32_t>(Codes::Instance::All) & 0xf)) | (1U << (static_cast<uint32_t>(instance) & 0xf));
+}
+
+void CAN::Acceptance_filter::Allow_message_type(Codes::Message_type message_type, bool allowed){
+    uint32_t code = static_cast<uint32_t>(message_type) & 0xfff;
+    if (allowed) {
+        message_type_mask[code >> 5] |= (1UL << (code & 0x1f));
+    } else {
+        message_type_mask[code >> 5] &= ~(1UL << (code & 0x1f));
+    }
+}
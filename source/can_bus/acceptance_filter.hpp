@@ -0,0 +1,94 @@
+/**
+ * @file acceptance_filter.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include <array>
+#include <stdint.h>
+
+#include "codes/codes.hpp"
+
+namespace CAN {
+
+/**
+ * @brief   Software acceptance filter for application messages, evaluated in receive ISR before frame is stored
+ *          Frame is accepted when its message type is registered (bypass), or when it is targeted to module type of this
+ *              module (or All/Any) and to instance of this module (or All), same rules as in Message_router
+ *          Filter is represented by bitmasks, so evaluation is constant time without any lookup
+ *          Until module type is set, all frames are accepted
+ */
+class Acceptance_filter {
+private:
+    /**
+     * @brief Mask of accepted module types (8 bit field of identifier)
+     */
+    inline static std::array<uint32_t, 256 / 32> module_mask = {};
+
+    /**
+     * @brief Mask of accepted instances (4 bit field of identifier)
+     */
+    inline static volatile uint16_t instance_mask = 0;
+
+    /**
+     * @brief Mask of message types accepted regardless of target module and instance (12 bit field of identifier)
+     */
+    inline static std::array<uint32_t, 4096 / 32> message_type_mask = {};
+
+    /**
+     * @brief Filter is enabled after module type is known
+     */
+    inline static volatile bool enabled = false;
+
+public:
+    /**
+     * @brief   Set module type of this module, enables filter
+     *
+     * @param module    Module type of this module
+     */
+    static void Module(Codes::Module module);
+
+    /**
+     * @brief   Set instance of this module, should be called every time enumerator changes instance
+     *
+     * @param instance  Current instance of this module
+     */
+    static void Instance(Codes::Instance instance);
+
+    /**
+     * @brief   Accept (or stop accepting) message type regardless of target module and instance
+     *
+     * @param message_type  Type of application message
+     * @param allowed       True if message type should be accepted
+     */
+    static void Allow_message_type(Codes::Message_type message_type, bool allowed = true);
+
+    /**
+     * @brief   Evaluate filter for identifier of received extended frame, executed in ISR
+     *
+     * @param id        29 bit identifier of frame
+     * @return true     Frame should be received
+     * @return false    Frame is not intended for this module
+     */
+    static inline bool Accept(uint32_t id){
+        if (not enabled) {
+            return true;
+        }
+
+        uint32_t message_type = (id >> 16) & 0xfff;
+        if (message_type_mask[message_type >> 5] & (1UL << (message_type & 0x1f))) {
+            return true;
+        }
+
+        uint32_t module = (id >> 4) & 0xff;
+        if (not (module_mask[module >> 5] & (1UL << (module & 0x1f)))) {
+            return false;
+        }
+
+        return instance_mask & (1U << (id & 0xf));
+    }
+};
+};
@@ -36,3 +36,19 @@ Codes::Instance Application_message::Instance_enumeration() const {
 Codes::Message_type Application_message::Message_type() const {
     return static_cast<Codes::Message_type>((id >> 16) & 0xfff);
 }
+
+bool Application_message::Emergency() const {
+    return id & emergency_flag;
+}
+
+void Application_message::Emergency(bool emergency){
+    if (emergency) {
+        id |= emergency_flag;
+    } else {
+        id &= ~emergency_flag;
+    }
+}
+
+bool Application_message::Emergency(CAN::Message const &message){
+    return message.Extended() and (message.ID() & emergency_flag);
+}
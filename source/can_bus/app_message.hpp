@@ -41,6 +41,11 @@ class Application_message : public CAN::Message {
     };
 
 public:
+    /**
+     * @brief   Construct a new empty Application_message object, used for pre-allocated message buffers
+     */
+    Application_message() = default;
+
     /**
      * @brief   Construct a new Application_message object, subset of CAN message with extended frame format without data
      *          Protected, to force use of variant which read data of Base module and cannot be used modified
@@ -110,4 +115,33 @@ public:
      * @return  Codes::Message_type   Type of message, which is sent, determine purpose and handling of message by corresponding module
      */
     Codes::Message_type Message_type() const;
+
+    /**
+     * @brief   Check if emergency flag of message is set, emergency messages are transmitted with highest priority
+     *
+     * @return true     Emergency flag is set
+     * @return false    Message is regular message
+     */
+    bool Emergency() const;
+
+    /**
+     * @brief   Set or clear emergency flag of message
+     *
+     * @param emergency     New state of emergency flag
+     */
+    void Emergency(bool emergency);
+
+    /**
+     * @brief   Check if emergency flag is set in identifier of extended CAN message
+     *
+     * @param message   CAN message
+     * @return true     Message is extended frame with emergency flag
+     * @return false    Message is standard frame or emergency flag is not set
+     */
+    static bool Emergency(CAN::Message const &message);
+
+    /**
+     * @brief   Position of emergency flag in identifier of message, see Header structure
+     */
+    static constexpr uint32_t emergency_flag = 1UL << 28;
 };
@@ -0,0 +1,26 @@
+/**
+ * @file bus_backend.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include "config.hpp"
+
+/**
+ * @brief   Selection of CAN bus backend used by CAN_thread, backend is selected during configuration
+ *          Both backends provide same interface (Transmit, Receive, Wait_for_any), so selection is resolved at compile time
+ */
+#if defined(CONFIG_CAN_BACKEND_LOOPBACK)
+    #include "can_bus/virtual_bus.hpp"
+    namespace CAN {
+        using Bus_backend = Virtual_bus;
+    }
+#else
+    #include "can_bus/can_bus.hpp"
+    namespace CAN {
+        using Bus_backend = Bus;
+    }
+#endif
@@ -0,0 +1,67 @@
+/**
+ * @file bus_statistics.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace CAN {
+
+/**
+ * @brief   Counters of CAN bus peripheral, updated from receive/transmit callback
+ *          Counters are only incremented and overflow naturally, consumers should evaluate differences
+ */
+struct Bus_statistics {
+    uint32_t rx_frames      = 0;    // Frames accepted into receive ring
+    uint32_t rx_bytes       = 0;    // Data bytes of accepted frames
+    uint32_t tx_frames      = 0;    // Frames transmitted by this node
+    uint32_t tx_bytes       = 0;    // Data bytes of transmitted frames
+    uint32_t rx_dropped     = 0;    // Frames dropped due to full receive ring
+    uint32_t rx_filtered    = 0;    // Frames rejected by acceptance filter
+    uint32_t errors         = 0;    // Error notifications of peripheral
+    uint32_t rx_high_water  = 0;    // Maximal number of messages waiting in receive ring
+    uint32_t bus_bits       = 0;    // Nominal number of bits of all frames observed on bus, used for utilization estimate
+
+    /**
+     * @brief   Nominal length of frame on bus without bit stuffing, including interframe space
+     *
+     * @param dlc       Number of data bytes
+     * @param extended  Frame uses extended (29 bit) identifier
+     * @return uint32_t Number of bits
+     */
+    static constexpr uint32_t Frame_bits(uint8_t dlc, bool extended){
+        return (extended ? 67 : 47) + 8 * dlc;
+    }
+};
+
+/**
+ * @brief   Identifiers of counters reported in CAN statistics response
+ *          Response is burst of frames, each frame contains [0] counter identifier, [1-4] value (big-endian)
+ */
+enum class Statistics_counter: uint8_t {
+    RX_frames,
+    RX_bytes,
+    TX_frames,
+    TX_bytes,
+    RX_dropped,
+    RX_filtered,
+    Errors,
+    RX_high_water,
+    TX_immediate,
+    TX_retransmits,
+    TX_dropped_emergency,
+    TX_dropped_normal,
+    TX_dropped_bulk,
+    TX_high_water_emergency,
+    TX_high_water_normal,
+    TX_high_water_bulk,
+    Utilization_permille,
+    TX_throttled_normal,
+    TX_throttled_bulk,
+};
+
+};
@@ -9,8 +9,6 @@ CAN::Bus::Bus(unsigned int gpio_rx, unsigned int gpio_tx, unsigned int bitrate,
 
     can2040_setup(&handler, pio_number);
 
-    rx_queue = new fra::Queue(64, sizeof(can2040_msg));
-
     instances[pio_number] = this;
 
     can2040_callback_config(&handler, &Bus::Callback_handler);
@@ -21,19 +19,48 @@ CAN::Bus::Bus(unsigned int gpio_rx, unsigned int gpio_tx, unsigned int bitrate,
 
 void CAN::Bus::Callback(uint32_t notify, struct can2040_msg *msg){
     IRQ_type type;
-    if(not (msg->id & CAN2040_ID_EFF)){
-        return;
-    }
     if (notify == CAN2040_NOTIFY_RX) {
         type     = IRQ_type::RX;
-        // Throw this away
-        BaseType_t *pxHigherPriorityTaskWoken = pdFALSE;
-        // Enqueue message to ISR safe queue, message is copied into queue
-        rx_queue->EnqueueFromISR(msg, pxHigherPriorityTaskWoken);
+        // Every frame observed on bus is counted into utilization, including frames not intended for this module
+        statistics.bus_bits += Bus_statistics::Frame_bits(msg->dlc, msg->id & CAN2040_ID_EFF);
+        if(not (msg->id & CAN2040_ID_EFF)){
+            return;
+        }
+        // Reject frames for other modules before they consume slot in ring or wake any thread
+        if (not Acceptance_filter::Accept(msg->id & 0x1fffffff)) {
+            statistics.rx_filtered++;
+            return;
+        }
+        // Decode message directly into receive ring, this is the only copy of received data
+        Application_message * slot = rx_ring.Reserve();
+        if (slot == nullptr) {
+            statistics.rx_dropped++;
+        } else {
+            slot->Decode(msg, time_us_32());
+            rx_ring.Commit();
+            statistics.rx_frames++;
+            statistics.rx_bytes += msg->dlc;
+            statistics.rx_high_water = std::max(statistics.rx_high_water, rx_ring.Size());
+        }
+        if (receive_listener != nullptr) {
+            BaseType_t higher_priority_task_woken = pdFALSE;
+            vTaskNotifyGiveFromISR(receive_listener, &higher_priority_task_woken);
+            portYIELD_FROM_ISR(higher_priority_task_woken);
+            return;
+        }
     } else if (notify == CAN2040_NOTIFY_TX) {
         type     = IRQ_type::TX;
+        if ((timestamped_id != 0) and (msg->id == timestamped_id)) {
+            transmit_timestamp = time_us_32();
+            transmit_timestamp_valid = true;
+            timestamped_id = 0;
+        }
+        statistics.tx_frames++;
+        statistics.tx_bytes += msg->dlc;
+        statistics.bus_bits += Bus_statistics::Frame_bits(msg->dlc, msg->id & CAN2040_ID_EFF);
     } else {
         type     = IRQ_type::Error;
+        statistics.errors++;
     }
     Emit(type);
 }
@@ -62,16 +89,13 @@ bool CAN::Bus::Transmit_available(){
 }
 
 uint8_t CAN::Bus::Received_queue_size(){
-        return rx_queue->NumItems();
-    }
+    return rx_ring.Size();
+}
 
-std::optional<can2040_msg> CAN::Bus::Receive() {
-    if(!rx_queue->IsEmpty()){
-        can2040_msg message_data;
-        // Read message from ISR safe queue
-        rx_queue->Dequeue(&message_data);
-        return message_data;
-    } else {
-        return {};
-    }
+Application_message const * CAN::Bus::Receive() const {
+    return rx_ring.Front();
+}
+
+void CAN::Bus::Release(){
+    rx_ring.Pop();
 }
@@ -10,17 +10,24 @@
 #include "hardware/pio.h"
 #include "hardware/irq.h"
 #include "hardware/clocks.h"
+#include "pico/time.h"
 
+#include <optional>
 #include <stdint.h>
 #include <vector>
 
 #include "queue.hpp"
+#include "task.h"
 
 #include "etl/unordered_map.h"
 #include "etl/queue.h"
 
 #include "hal/irq/irq_capable.hpp"
 #include "can_message.hpp"
+#include "app_message.hpp"
+#include "acceptance_filter.hpp"
+#include "bus_statistics.hpp"
+#include "tools/spsc_ring.hpp"
 
 #include "logger.hpp"
 #include "emio/emio.hpp"
@@ -66,16 +73,31 @@ private:
     inline static etl::unordered_map<uint, CAN::Bus *, 2> instances;
 
     /**
-     * @brief   Last received message, overwritten by new one when new message is received
-     *          Message caching needs to be implemented in higher level
+     * @brief   Ring of received messages, written directly from ISR and read in place by message router
+     *          Messages are decoded only once, when they are received, and are never copied afterwards
      */
-    std::optional<Message> last_received;
+    SPSC_ring<Application_message, 64> rx_ring;
 
     /**
-     * @brief   Queue containing raw can2040 messages received from can bus
-     *          Queue is ISR safe, implemented as part of FreeRTOS sync routines
+     * @brief   Counters of received, transmitted, dropped and filtered frames and errors, updated from ISR
      */
-    fra::Queue * rx_queue;
+    Bus_statistics statistics;
+
+    /**
+     * @brief   Task notified directly from ISR when message is stored into receive ring
+     */
+    TaskHandle_t receive_listener = nullptr;
+
+    /**
+     * @brief   Identifier of frame (including can2040 flags) which time of transmission should be captured, 0 when not armed
+     */
+    volatile uint32_t timestamped_id = 0;
+
+    /**
+     * @brief   Time of transmission of armed frame (lower 32 bits of system timer), valid when timestamped_id was cleared
+     */
+    volatile uint32_t transmit_timestamp = 0;
+    volatile bool transmit_timestamp_valid = false;
 
 public:
     /**
@@ -148,11 +170,17 @@ public:
     bool Transmit_available();
 
     /**
-     * @brief Returns last received message on CAN bus
+     * @brief   Returns oldest received message, message is not removed from receive ring
+     *          Message stays valid until Release is called
      *
-     * @return std::optional<can2040_msg>   Last received message if any was received, otherwise empty optional
+     * @return Application_message const*   Oldest received message, nullptr if no message is waiting
      */
-    std::optional<can2040_msg> Receive();
+    Application_message const * Receive() const;
+
+    /**
+     * @brief   Remove oldest received message (obtained by Receive) from receive ring
+     */
+    void Release();
 
     /**
      * @brief   Returns number of messages in receive queue waiting for processing
@@ -161,6 +189,58 @@ public:
      */
     uint8_t Received_queue_size();
 
+    /**
+     * @brief   Number of received messages dropped due to full receive ring
+     *
+     * @return uint32_t Number of dropped messages
+     */
+    uint32_t Dropped_messages() const { return statistics.rx_dropped; };
+
+    /**
+     * @brief   Number of received messages rejected by acceptance filter
+     *
+     * @return uint32_t Number of rejected messages
+     */
+    uint32_t Filtered_messages() const { return statistics.rx_filtered; };
+
+    /**
+     * @brief   Counters of peripheral
+     *
+     * @return Bus_statistics const&    Counters of frames, bytes, drops and errors
+     */
+    Bus_statistics const & Stats() const { return statistics; };
+
+    /**
+     * @brief   Capture time of transmission of next frame with same identifier as message, previous timestamp is invalidated
+     *          Used by time synchronization master, transmission time is taken in TX interrupt same as receive time on other nodes
+     *
+     * @param message   Message which time of transmission should be captured
+     */
+    void Timestamp_transmit(Message const &message){
+        transmit_timestamp_valid = false;
+        timestamped_id = message.to_msg().id;
+    };
+
+    /**
+     * @brief   Time of transmission of frame armed by Timestamp_transmit
+     *
+     * @return std::optional<uint32_t>  Lower 32 bits of system timer in us, empty if frame was not transmitted yet
+     */
+    std::optional<uint32_t> Transmit_timestamp() const {
+        if (not transmit_timestamp_valid) {
+            return std::nullopt;
+        }
+        return transmit_timestamp;
+    };
+
+    /**
+     * @brief   Register task which is notified (task notification) directly from ISR when new message is received
+     *          When listener is registered, RX IRQ is not emitted anymore, messages are processed only by listener
+     *
+     * @param task  Handle of task processing received messages
+     */
+    void Notify_on_receive(TaskHandle_t task){ receive_listener = task; };
+
 private:
     /**
      * @brief   Enable IRQ for PIO unit used by this CAN bus peripheral
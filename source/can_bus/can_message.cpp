@@ -1,6 +1,11 @@
 #include "can_message.hpp"
 #include <algorithm>
 
+CAN::Message::Message()
+    :
+    id(0),
+    data(){ }
+
 CAN::Message::Message(uint32_t id, bool extended, bool remote_request)
     :
     id(id),
@@ -30,6 +35,16 @@ CAN::Message::Message(can2040_msg *msg)
     std::copy(msg->data, msg->data + msg->dlc, data.begin());
 }
 
+void CAN::Message::Decode(can2040_msg const *msg, uint32_t timestamp_us){
+    id = msg->id & 0x1fffffff;
+    extended = msg->id & CAN2040_ID_EFF;
+    remote_request = msg->id & CAN2040_ID_RTR;
+    receive_time = timestamp_us;
+    uint8_t length = std::min<uint32_t>(msg->dlc, 8);
+    data.resize(length);
+    std::copy(msg->data, msg->data + length, data.begin());
+}
+
 uint32_t CAN::Message::ID() const {
     return id;
 }
@@ -42,6 +57,10 @@ bool CAN::Message::Remote() const {
     return remote_request;
 }
 
+uint32_t CAN::Message::Receive_time() const {
+    return receive_time;
+}
+
 can2040_msg CAN::Message::to_msg() const {
     struct can2040_msg can_message = { };
     can_message.id = id;
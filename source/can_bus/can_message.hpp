@@ -14,6 +14,17 @@ extern "C" {
 #include "etl/vector.h"
 
 namespace CAN {
+
+/**
+ * @brief   Priority class of transmitted message, messages from higher class are always transmitted first
+ *          Emergency class corresponds to Emergency_flag of application message
+ */
+enum class TX_priority: uint8_t {
+    Emergency,
+    Normal,
+    Bulk,
+};
+
 /**
  * @brief   Representation of CAN message, including ID, data and flags
  *          Support for CAN2.0B extended and remote frames with 29 bit identifiers
@@ -35,6 +46,11 @@ protected:
      */
     bool remote_request = false;
 
+    /**
+     * @brief Timestamp of reception in microseconds (lower 32 bits of system timer), 0 for locally created messages
+     */
+    uint32_t receive_time = 0;
+
 public:
     /**
      * @brief Data of message, maximum 8 bytes
@@ -42,6 +58,11 @@ public:
     etl::vector<uint8_t, 8> data;
 
 public:
+    /**
+     * @brief Construct a new empty Message object, used for pre-allocated message buffers
+     */
+    Message();
+
     /**
      * @brief Construct a new Message object without data
      *
@@ -78,6 +99,15 @@ public:
      */
     explicit Message(can2040_msg *msg);
 
+    /**
+     * @brief   Overwrite content of message by can2040 message, no allocation is performed
+     *          Used to decode received frame directly into pre-allocated buffer (from ISR)
+     *
+     * @param msg           Pointer to can2040 message
+     * @param timestamp_us  Time of reception in microseconds
+     */
+    void Decode(can2040_msg const *msg, uint32_t timestamp_us = 0);
+
     /**
      * @brief Get the ID of CAN bus message
      *
@@ -101,6 +131,24 @@ public:
      */
     bool Remote() const;
 
+    /**
+     * @brief Time of reception of message, captured in receive ISR
+     *
+     * @return uint32_t Timestamp in microseconds (lower 32 bits of system timer), 0 if message was not received from bus
+     */
+    uint32_t Receive_time() const;
+
+    /**
+     * @brief Extend 32-bit timestamp captured in interrupt (receive or transmit) to 64-bit time, timestamp is always in past
+     *
+     * @param timestamp_us  Lower 32 bits of system timer at time of event
+     * @param now_us        Current 64-bit time
+     * @return uint64_t     64-bit time of event
+     */
+    static uint64_t Extend_timestamp(uint32_t timestamp_us, uint64_t now_us){
+        return now_us - static_cast<uint32_t>(static_cast<uint32_t>(now_us) - timestamp_us);
+    }
+
     /**
      * @brief Convert Message object to can2040 message
      *
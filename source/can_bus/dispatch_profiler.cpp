@@ -0,0 +1,141 @@
+#include "dispatch_profiler.hpp"
+
+#include <algorithm>
+
+#include "modules/base_module.hpp"
+#include "logger.hpp"
+
+void Dispatch_profiler::Begin(Application_message const &message){
+    dispatching = Origin{message.Message_type(), message.Receive_time()};
+    deferred = false;
+}
+
+void Dispatch_profiler::Record(Application_message const &message, uint32_t start_us, uint32_t end_us){
+    bool completed = not deferred;
+    dispatching.reset();
+    deferred = false;
+
+    Profile * profile = Find(message.Message_type());
+    if (profile == nullptr) {
+        return;
+    }
+
+    uint32_t handler_us = end_us - start_us;
+    profile->calls++;
+    profile->handler_min_us = std::min(profile->handler_min_us, handler_us);
+    profile->handler_max_us = std::max(profile->handler_max_us, handler_us);
+    profile->handler_sum_us += handler_us;
+
+    // Messages injected locally (telemetry) have no receive timestamp
+    if (completed and (message.Receive_time() != 0)) {
+        profile->completion.Record(end_us - message.Receive_time());
+    }
+}
+
+std::optional<Dispatch_profiler::Origin> Dispatch_profiler::Defer_origin(){
+    if (dispatching.has_value()) {
+        deferred = true;
+    }
+    return dispatching;
+}
+
+void Dispatch_profiler::Record_job(Origin const &origin, uint32_t start_us, uint32_t end_us){
+    Profile * profile = Find(origin.type);
+    if (profile == nullptr) {
+        return;
+    }
+
+    uint32_t job_us = end_us - start_us;
+    profile->jobs++;
+    profile->job_min_us = std::min(profile->job_min_us, job_us);
+    profile->job_max_us = std::max(profile->job_max_us, job_us);
+    profile->job_sum_us += job_us;
+
+    if (origin.completes) {
+        Record_completion(origin, end_us);
+    }
+}
+
+void Dispatch_profiler::Record_completion(Origin const &origin, uint32_t end_us){
+    Profile * profile = Find(origin.type);
+    if ((profile == nullptr) or (origin.receive_us == 0)) {
+        return;
+    }
+    profile->completion.Record(end_us - origin.receive_us);
+}
+
+Dispatch_profiler::Profile * Dispatch_profiler::Find(Codes::Message_type type){
+    auto profile = std::find_if(profiles.begin(), profiles.end(), [type](Profile const &entry){
+        return entry.type == type;
+    });
+
+    if (profile == profiles.end()) {
+        if (profiles.full()) {
+            untracked++;
+            return nullptr;
+        }
+        profiles.push_back(Profile{type});
+        profile = profiles.end() - 1;
+    }
+    return &(*profile);
+}
+
+bool Dispatch_profiler::Receive(Application_message const &message){
+    if (message.data.size() >= 2) {
+        auto type = static_cast<Codes::Message_type>((message.data[0] << 8) | message.data[1]);
+        auto profile = std::find_if(profiles.begin(), profiles.end(), [type](Profile const &entry){
+            return entry.type == type;
+        });
+        if (profile == profiles.end()) {
+            Logger::Warning("No dispatch profile of {}", Codes::to_string(type));
+            return false;
+        }
+        Report(*profile);
+        return true;
+    }
+
+    for (auto const &profile : profiles) {
+        Report(profile);
+    }
+    return true;
+}
+
+void Dispatch_profiler::Report(Profile const &profile){
+    uint16_t type = static_cast<uint16_t>(profile.type);
+
+    auto send_field = [type](uint8_t field, uint32_t value){
+        etl::vector<uint8_t, 8> data = {
+            static_cast<uint8_t>(type >> 8),
+            static_cast<uint8_t>(type),
+            field,
+            static_cast<uint8_t>(value >> 24),
+            static_cast<uint8_t>(value >> 16),
+            static_cast<uint8_t>(value >> 8),
+            static_cast<uint8_t>(value),
+        };
+        Application_message response(Codes::Message_type::Core_dispatch_statistics_response, data);
+        Base_module::Send_CAN_message(response, CAN::TX_priority::Bulk);
+    };
+
+    uint32_t average = profile.calls ? profile.handler_sum_us / profile.calls : 0;
+    uint32_t minimum = profile.calls ? profile.handler_min_us : 0;
+
+    send_field(static_cast<uint8_t>(Field::Calls), profile.calls);
+    send_field(static_cast<uint8_t>(Field::Handler_min), minimum);
+    send_field(static_cast<uint8_t>(Field::Handler_avg), average);
+    send_field(static_cast<uint8_t>(Field::Handler_max), profile.handler_max_us);
+    send_field(static_cast<uint8_t>(Field::Completion_max), profile.completion.max_us);
+
+    if (profile.jobs != 0) {
+        send_field(static_cast<uint8_t>(Field::Jobs), profile.jobs);
+        send_field(static_cast<uint8_t>(Field::Job_min), profile.job_min_us);
+        send_field(static_cast<uint8_t>(Field::Job_avg), profile.job_sum_us / profile.jobs);
+        send_field(static_cast<uint8_t>(Field::Job_max), profile.job_max_us);
+    }
+
+    for (uint8_t bucket = 0; bucket < Latency_histogram::bucket_count; bucket++) {
+        if (profile.completion.counts[bucket] != 0) {
+            send_field(static_cast<uint8_t>(Field::Completion_bucket) + bucket, profile.completion.counts[bucket]);
+        }
+    }
+}
@@ -0,0 +1,174 @@
+/**
+ * @file dispatch_profiler.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include <optional>
+#include <stdint.h>
+
+#include "codes/codes.hpp"
+#include "can_bus/app_message.hpp"
+#include "can_bus/latency_probe.hpp"
+
+#include "etl/vector.h"
+
+/**
+ * @brief   Profile of message handlers, records execution time of Receive method of component per message type
+ *          Used to find handlers which block dispatcher
+ *          Handlers which defer work to Job_executor only enqueue job, execution time of deferred jobs is recorded separately
+ *              and time to completion of such message is measured at end of job instead of return of handler
+ *          Profiles are kept for limited number of message types, types received after table is full are only counted as untracked
+ *          Core_dispatch_statistics_request data: [0-1] message type (big-endian) to report single type, empty to report all types
+ *          Response is burst of Core_dispatch_statistics_response frames:
+ *              [0-1] message type (big-endian), [2] field, [3-6] value (big-endian)
+ *              Fields: 0 - calls, 1 - minimal handler time (us), 2 - average handler time (us), 3 - maximal handler time (us),
+ *                      4 - maximal time from receive ISR to handler completion (us), 5 - deferred jobs,
+ *                      6 - minimal job time (us), 7 - average job time (us), 8 - maximal job time (us),
+ *                      0x10 + N - number of messages in bucket N of histogram of receive ISR to handler completion (only non-empty)
+ */
+class Dispatch_profiler {
+public:
+    /**
+     * @brief   Maximal number of profiled message types
+     */
+    static constexpr size_t max_profiles = 24;
+
+    /**
+     * @brief   Statistics of handler of one message type
+     */
+    struct Profile {
+        Codes::Message_type type;
+        uint32_t            calls           = 0;
+        uint32_t            handler_min_us  = UINT32_MAX;
+        uint32_t            handler_max_us  = 0;
+        uint64_t            handler_sum_us  = 0;
+        uint32_t            jobs            = 0;    // Jobs deferred by handler and executed by Job_executor
+        uint32_t            job_min_us      = UINT32_MAX;
+        uint32_t            job_max_us      = 0;
+        uint64_t            job_sum_us      = 0;
+        Latency_histogram   completion;     // Receive ISR to handler (or deferred job) completion, only messages received from bus
+    };
+
+    /**
+     * @brief   Message which handler deferred job, passed with job to executor
+     */
+    struct Origin {
+        Codes::Message_type type;
+        uint32_t            receive_us;
+        bool                completes = true;   // Completion of job is completion of message, false for partial jobs
+    };
+
+    /**
+     * @brief   Identifiers of fields in response
+     */
+    enum class Field: uint8_t {
+        Calls               = 0x00,
+        Handler_min         = 0x01,
+        Handler_avg         = 0x02,
+        Handler_max         = 0x03,
+        Completion_max      = 0x04,
+        Jobs                = 0x05,
+        Job_min             = 0x06,
+        Job_avg             = 0x07,
+        Job_max             = 0x08,
+        Completion_bucket   = 0x10,
+    };
+
+private:
+    /**
+     * @brief   Profiles in order of first occurrence of message type
+     */
+    inline static etl::vector<Profile, max_profiles> profiles;
+
+    /**
+     * @brief   Number of dispatched messages which types have no profile due to full table
+     */
+    inline static uint32_t untracked = 0;
+
+    /**
+     * @brief   Message which handler is currently executed by router, empty outside of dispatch
+     */
+    inline static std::optional<Origin> dispatching = std::nullopt;
+
+    /**
+     * @brief   Handler of currently dispatched message deferred job, completion is recorded by job
+     */
+    inline static bool deferred = false;
+
+public:
+    /**
+     * @brief   Mark start of handler of message, called by router before handler is invoked
+     *
+     * @param message   Dispatched message
+     */
+    static void Begin(Application_message const &message);
+
+    /**
+     * @brief   Record execution of handler, called by router after handler returns
+     *
+     * @param message       Dispatched message
+     * @param start_us      Time when handler was invoked (lower 32 bits of system timer)
+     * @param end_us        Time when handler returned (lower 32 bits of system timer)
+     */
+    static void Record(Application_message const &message, uint32_t start_us, uint32_t end_us);
+
+    /**
+     * @brief   Origin of job deferred by currently executed handler, marks message as deferred
+     *
+     * @return std::optional<Origin>    Currently dispatched message, empty when job is not deferred from handler
+     */
+    static std::optional<Origin> Defer_origin();
+
+    /**
+     * @brief   Record execution of deferred job, called by Job_executor after job returns
+     *
+     * @param origin    Message which handler deferred job
+     * @param start_us  Time when job was started (lower 32 bits of system timer)
+     * @param end_us    Time when job returned (lower 32 bits of system timer)
+     */
+    static void Record_job(Origin const &origin, uint32_t start_us, uint32_t end_us);
+
+    /**
+     * @brief   Record completion of message which was processed by multiple jobs
+     *
+     * @param origin    Message which handler deferred jobs
+     * @param end_us    Time when processing was completed (lower 32 bits of system timer)
+     */
+    static void Record_completion(Origin const &origin, uint32_t end_us);
+
+    /**
+     * @brief   Process Core_dispatch_statistics_request, send profiles as burst of responses
+     *
+     * @param message   Received request
+     * @return true     Response was sent
+     * @return false    Requested message type has no profile
+     */
+    static bool Receive(Application_message const &message);
+
+    /**
+     * @brief   Recorded profiles
+     */
+    static etl::ivector<Profile> const & Profiles(){ return profiles; };
+
+    /**
+     * @brief   Number of dispatched messages without profile
+     */
+    static uint32_t Untracked(){ return untracked; };
+
+private:
+    /**
+     * @brief   Find profile of message type, new profile is created on first occurrence
+     *
+     * @return Profile*     Profile of message type, nullptr when table is full
+     */
+    static Profile * Find(Codes::Message_type type);
+
+    /**
+     * @brief   Send all fields of profile
+     */
+    static void Report(Profile const &profile);
+};
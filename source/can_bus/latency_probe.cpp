@@ -0,0 +1,145 @@
+#include "latency_probe.hpp"
+
+#include "modules/base_module.hpp"
+#include "threads/job_executor.hpp"
+#include "rtos/wrappers.hpp"
+#include "logger.hpp"
+
+#include "pico/time.h"
+
+bool Latency_probe::Receive(Application_message const &message){
+    switch (message.Message_type()) {
+        case Codes::Message_type::Latency_probe_request:
+            return Probe(message);
+
+        case Codes::Message_type::Latency_histogram_request:
+            return Report();
+
+        default:
+            return false;
+    }
+}
+
+void Latency_probe::Reset(){
+    for (auto &histogram : histograms) {
+        histogram = {};
+    }
+}
+
+bool Latency_probe::Probe(Application_message const &message){
+    uint64_t dispatch_us = time_us_64();
+
+    if (message.data.size() < 1) {
+        Logger::Warning("Latency probe without sequence number");
+        return false;
+    }
+
+    uint8_t sequence = message.data[0];
+    uint8_t flags = message.data.size() > 1 ? message.data[1] : 0;
+    if (flags & 0x01) {
+        Reset();
+    }
+
+    uint64_t receive_us = Application_message::Extend_timestamp(message.Receive_time(), dispatch_us);
+
+    // First response is measured frame, enqueue is captured when CAN thread accepted it
+    CAN_thread * can_thread = Base_module::CAN_manager();
+    Application_message receive_response = Stage_response(sequence, Stage::Receive, receive_us);
+    if (can_thread != nullptr) {
+        can_thread->Timestamp_transmit(receive_response);
+    }
+    Base_module::Send_CAN_message(receive_response);
+    uint64_t enqueue_us = time_us_64();
+
+    Base_module::Send_CAN_message(Stage_response(sequence, Stage::Dispatch, dispatch_us));
+    Base_module::Send_CAN_message(Stage_response(sequence, Stage::Enqueue, enqueue_us));
+
+    // Probes injected locally (without receive timestamp) are not recorded
+    bool record = message.Receive_time() != 0;
+    if (record) {
+        histograms[static_cast<uint8_t>(Interval::Receive_to_dispatch)].Record(dispatch_us - receive_us);
+        histograms[static_cast<uint8_t>(Interval::Dispatch_to_enqueue)].Record(enqueue_us - dispatch_us);
+    }
+
+    if (can_thread != nullptr) {
+        Job_executor::Submit(Codes::Component::Common_core, [sequence, enqueue_us, record](){
+            Transmit_stage(sequence, enqueue_us, record);
+        }, Dispatch_profiler::Defer_origin());
+    }
+
+    Logger::Trace("Latency probe {}: dispatch {} us, enqueue {} us", (short)sequence, dispatch_us - receive_us, enqueue_us - dispatch_us);
+    return true;
+}
+
+void Latency_probe::Transmit_stage(uint8_t sequence, uint64_t enqueue_us, bool record){
+    CAN_thread * can_thread = Base_module::CAN_manager();
+
+    std::optional<uint32_t> transmit_timestamp = std::nullopt;
+    for (uint32_t attempt = 0; attempt < transmit_timeout_ms; attempt++) {
+        transmit_timestamp = can_thread->Transmit_timestamp();
+        if (transmit_timestamp.has_value()) {
+            break;
+        }
+        rtos::Delay(1);
+    }
+
+    if (not transmit_timestamp.has_value()) {
+        Logger::Warning("Latency probe {} response was not transmitted", (short)sequence);
+        return;
+    }
+
+    uint64_t transmit_us = Application_message::Extend_timestamp(transmit_timestamp.value(), time_us_64());
+    Base_module::Send_CAN_message(Stage_response(sequence, Stage::Transmit, transmit_us));
+
+    if (record) {
+        histograms[static_cast<uint8_t>(Interval::Enqueue_to_transmit)].Record(transmit_us - enqueue_us);
+    }
+}
+
+Application_message Latency_probe::Stage_response(uint8_t sequence, Stage stage, uint64_t timestamp){
+    etl::vector<uint8_t, 8> data = {
+        sequence,
+        static_cast<uint8_t>(stage),
+        static_cast<uint8_t>(timestamp >> 40),
+        static_cast<uint8_t>(timestamp >> 32),
+        static_cast<uint8_t>(timestamp >> 24),
+        static_cast<uint8_t>(timestamp >> 16),
+        static_cast<uint8_t>(timestamp >> 8),
+        static_cast<uint8_t>(timestamp),
+    };
+    return Application_message(Codes::Message_type::Latency_probe_response, data);
+}
+
+bool Latency_probe::Report(){
+    for (uint8_t index = 0; index < histograms.size(); index++) {
+        Latency_histogram const &histogram = histograms[index];
+        for (uint8_t bucket = 0; bucket < Latency_histogram::bucket_count; bucket++) {
+            uint32_t count = histogram.counts[bucket];
+            if (count == 0) {
+                continue;
+            }
+            etl::vector<uint8_t, 8> data = {
+                index,
+                bucket,
+                static_cast<uint8_t>(count >> 24),
+                static_cast<uint8_t>(count >> 16),
+                static_cast<uint8_t>(count >> 8),
+                static_cast<uint8_t>(count),
+            };
+            Application_message response(Codes::Message_type::Latency_histogram_response, data);
+            Base_module::Send_CAN_message(response, CAN::TX_priority::Bulk);
+        }
+
+        etl::vector<uint8_t, 8> data = {
+            index,
+            0xff,
+            static_cast<uint8_t>(histogram.max_us >> 24),
+            static_cast<uint8_t>(histogram.max_us >> 16),
+            static_cast<uint8_t>(histogram.max_us >> 8),
+            static_cast<uint8_t>(histogram.max_us),
+        };
+        Application_message response(Codes::Message_type::Latency_histogram_response, data);
+        Base_module::Send_CAN_message(response, CAN::TX_priority::Bulk);
+    }
+    return true;
+}
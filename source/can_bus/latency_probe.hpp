@@ -0,0 +1,145 @@
+/**
+ * @file latency_probe.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <stdint.h>
+
+#include "codes/codes.hpp"
+#include "can_bus/app_message.hpp"
+
+#include "etl/array.h"
+
+/**
+ * @brief   Histogram of latencies with logarithmic buckets
+ *          Bucket 0 contains zero latency, bucket N contains latencies from 2^(N-1) to 2^N - 1 us, last bucket contains all longer
+ */
+struct Latency_histogram {
+    static constexpr uint8_t bucket_count = 16;
+
+    etl::array<uint32_t, bucket_count> counts = {};
+    uint32_t max_us = 0;
+
+    /**
+     * @brief   Add latency to histogram
+     *
+     * @param latency_us    Latency in microseconds
+     */
+    void Record(uint32_t latency_us){
+        uint8_t bucket = std::min<uint8_t>(std::bit_width(latency_us), bucket_count - 1);
+        counts[bucket]++;
+        max_us = std::max(max_us, latency_us);
+    }
+
+    /**
+     * @brief   Lower bound of bucket in microseconds
+     */
+    static constexpr uint32_t Bucket_floor(uint8_t bucket){
+        return bucket == 0 ? 0 : (1u << (bucket - 1));
+    }
+};
+
+/**
+ * @brief   Responder of latency probes, separates bus latency from queueing latency inside of firmware
+ *          Latency_probe_request data: [0] sequence number, [1] flags (bit 0 resets histograms before probe is recorded)
+ *          Module responds by four Latency_probe_response frames, one per stage of processing of request:
+ *              [0] sequence number, [1] stage (0 - receive ISR, 1 - dispatch, 2 - transmit enqueue, 3 - transmit complete),
+ *              [2-7] timestamp of stage in us from time_us_64 (lower 48 bits, big-endian)
+ *          Enqueue and transmit stages are measured on first response (receive stage), enqueue is time when CAN thread accepted it,
+ *              transmit complete is captured in TX interrupt and reported by job after frame leaves peripheral
+ *          Time synchronization master uses same transmit timestamp, probe during its broadcast may not report transmit stage
+ *          Every probe is recorded into histograms of intervals receive -> dispatch, dispatch -> enqueue and enqueue -> transmit,
+ *              histograms are read by Latency_histogram_request, response is burst of Latency_histogram_response frames:
+ *              [0] histogram (0 - receive to dispatch, 1 - dispatch to enqueue, 2 - enqueue to transmit), [1] bucket, [2-5] count (big-endian)
+ *              only non-empty buckets are sent, bucket 0xff carries maximal latency instead of count
+ */
+class Latency_probe {
+public:
+    /**
+     * @brief   Stages of processing of probe, reported in response
+     */
+    enum class Stage: uint8_t {
+        Receive     = 0,
+        Dispatch    = 1,
+        Enqueue     = 2,
+        Transmit    = 3,
+    };
+
+    /**
+     * @brief   Recorded intervals
+     */
+    enum class Interval: uint8_t {
+        Receive_to_dispatch = 0,
+        Dispatch_to_enqueue = 1,
+        Enqueue_to_transmit = 2,
+    };
+
+private:
+    /**
+     * @brief   Histograms of intervals (index is Interval)
+     */
+    inline static etl::array<Latency_histogram, 3> histograms = {};
+
+    /**
+     * @brief   Maximal time of waiting for transmission of measured response
+     */
+    static constexpr uint32_t transmit_timeout_ms = 20;
+
+public:
+    /**
+     * @brief   Process Latency_probe_request or Latency_histogram_request
+     *          Must be called directly from dispatcher, time of call is used as dispatch timestamp
+     *
+     * @param message   Received request
+     * @return true     Response was sent
+     * @return false    Request is malformed
+     */
+    static bool Receive(Application_message const &message);
+
+    /**
+     * @brief   Histogram of interval
+     *
+     * @param interval  Recorded interval
+     * @return Latency_histogram const&     Histogram of interval
+     */
+    static Latency_histogram const & Histogram(Interval interval){
+        return histograms[static_cast<uint8_t>(interval)];
+    }
+
+    /**
+     * @brief   Clear all histograms
+     */
+    static void Reset();
+
+private:
+    /**
+     * @brief   Respond to probe with timestamps of stages and record intervals
+     */
+    static bool Probe(Application_message const &message);
+
+    /**
+     * @brief   Send all non-empty buckets of histograms
+     */
+    static bool Report();
+
+    /**
+     * @brief   Wait for transmission of measured response, then report transmit stage and record enqueue -> transmit interval
+     *          Executed as job, so dispatcher is not blocked by waiting
+     *
+     * @param sequence      Sequence number of probe
+     * @param enqueue_us    Time when measured response was accepted by CAN thread
+     * @param record        Interval is recorded into histogram
+     */
+    static void Transmit_stage(uint8_t sequence, uint64_t enqueue_us, bool record);
+
+    /**
+     * @brief   Create response reporting timestamp of stage
+     */
+    static Application_message Stage_response(uint8_t sequence, Stage stage, uint64_t timestamp);
+};
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <span>
+
 #include "can_bus/app_message.hpp"
 #include "codes/codes.hpp"
 #include "can_message.hpp"
@@ -37,7 +39,7 @@ public:
      * @return true     Message was processed by this object
      * @return false    Message cannot be processed by this object
      */
-    virtual bool Receive(CAN::Message message) = 0;
+    virtual bool Receive(CAN::Message const &message) = 0;
 
     /**
      * @brief   Method which is called when Application message is received by router
@@ -46,5 +48,22 @@ public:
      * @return true     Message was processed by this object
      * @return false    Message cannot be processed by this object
      */
-    virtual bool Receive(Application_message message) = 0;
+    virtual bool Receive(Application_message const &message) = 0;
+
+    /**
+     * @brief   Method which is called when payload of segmented transfer is completely received
+     *          Components which do not accept large payloads does not need to implement it
+     *
+     * @param module    Module which sent payload
+     * @param instance  Instance of module which sent payload
+     * @param payload   Received payload, valid only during call
+     * @return true     Payload was processed by this object
+     * @return false    Payload cannot be processed by this object
+     */
+    virtual bool Receive_segmented(Codes::Module module, Codes::Instance instance, std::span<const uint8_t> payload){
+        UNUSED(module);
+        UNUSED(instance);
+        UNUSED(payload);
+        return false;
+    };
 };
@@ -1,18 +1,26 @@
 #include "message_router.hpp"
 
-bool Message_router::Route(CAN::Message message){
+#include "pico/time.h"
+
+bool Message_router::Route(Application_message const &message){
     // Process application messages
     if(message.Extended()){
-        Application_message app_message = Application_message(message);
+        Application_message const &app_message = message;
 
         Codes::Message_type message_type = app_message.Message_type();
 
         Logger::Trace("Routing message: {}", Codes::to_string(message_type));
 
-        // Filter messages by target module if not in bypass list
-        auto bypass = bypass_routing_table.find(message_type);
+        // Responses to pending requests of this module are consumed by tracker
+        if (Request_tracker::Match(app_message)) {
+            return true;
+        }
+
+        bool bypass = false;
+        Message_receiver * instance = Resolve(message_type, bypass);
 
-        if (bypass == bypass_routing_table.end()) {
+        // Filter messages by target module if not in bypass list
+        if (not bypass) {
             // Check if current module is target module
             Codes::Module target_module = app_message.Module_type();
             if (target_module != Codes::Module::All and target_module != Codes::Module::Any and target_module != Base_module::Module_type()){
@@ -34,31 +42,16 @@ bool Message_router::Route(CAN::Message message){
                     Logger::Warning("Undefined instance of module");
                 }
             }
-        } else {
-            Message_receiver* instance = component_instances[bypass->second];
-            if (instance) {
-                instance->Receive(app_message);
-                return true;
-            } else {
-                Logger::Warning("Message receiver instance not found");
-                return false;
-            }
         }
 
-        // Find component which should receive this message
-        auto receiver = Routing_table.find(message_type);
-        if (receiver != Routing_table.end()){
-            Codes::Component component = receiver->second;
-            Message_receiver * instance = component_instances[component];
-            if (instance) {
-                instance->Receive(app_message);
-                return true;
-            } else {
-                Logger::Warning("Message receiver instance not found");
-                return false;
-            }
+        if (instance) {
+            Dispatch_profiler::Begin(app_message);
+            uint32_t start_us = time_us_32();
+            instance->Receive(app_message);
+            Dispatch_profiler::Record(app_message, start_us, time_us_32());
+            return true;
         } else {
-            Logger::Warning("Message receiver component not found");
+            Logger::Warning("Message receiver instance not found");
             return false;
         }
     // Process admin messages
@@ -67,9 +60,9 @@ bool Message_router::Route(CAN::Message message){
         auto receiver = Admin_routing_table.find(cmd);
         if (receiver != Admin_routing_table.end()){
             Codes::Component component = receiver->second;
-            Message_receiver * instance = component_instances[component];
+            Message_receiver * instance = component_instances[static_cast<uint32_t>(component) % component_table_size];
             if (instance) {
-                instance->Receive(message);
+                instance->Receive(static_cast<CAN::Message const &>(message));
                 return true;
             } else {
                 Logger::Warning("Command receiver not found");
@@ -80,17 +73,48 @@ bool Message_router::Route(CAN::Message message){
     return false;
 }
 
+Message_receiver * Message_router::Resolve(Codes::Message_type message_type, bool &bypass){
+    uint16_t type_index = static_cast<uint16_t>(message_type) & (Message_type_count - 1);
+    Codes::Component component;
+
+    bypass = bypass_mask.test(type_index);
+    if (bypass) {
+        component = bypass_routing_table[type_index];
+    } else {
+        Dispatch_entry const &entry = Dispatch_table[type_index];
+        if (not entry.routed) {
+            return nullptr;
+        }
+        component = entry.component;
+    }
+
+    return component_instances[static_cast<uint32_t>(component) % component_table_size];
+}
+
+Message_receiver * Message_router::Receiver(Codes::Component component){
+    return component_instances[static_cast<uint32_t>(component) % component_table_size];
+}
+
 void Message_router::Register_receiver(Codes::Component component, Message_receiver * receiver){
-    auto record = component_instances.find(component);
+    uint32_t index = static_cast<uint32_t>(component);
+    if (index >= component_table_size) {
+        Logger::Error("Component code out of range of receiver table");
+        return;
+    }
     // Overwrite existing record
-    if (record != component_instances.end()){
+    if (component_instances[index] != nullptr){
         Logger::Warning("Component already registered, overwriting");
-        record->second = receiver;
-    } else {
-        component_instances[component] = receiver;
     }
+    component_instances[index] = receiver;
 }
 
 void Message_router::Register_bypass(Codes::Message_type message_type, Codes::Component component_code) {
-    bypass_routing_table.insert({message_type, component_code});
+    uint16_t type_index = static_cast<uint16_t>(message_type) & (Message_type_count - 1);
+    if (bypass_routing_table.full() and not bypass_mask.test(type_index)) {
+        Logger::Error("Bypass routing table full, bypass not registered");
+        return;
+    }
+    bypass_routing_table[type_index] = component_code;
+    bypass_mask.set(type_index);
+    CAN::Acceptance_filter::Allow_message_type(message_type);
 }
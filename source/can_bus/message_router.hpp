@@ -16,8 +16,14 @@
 #include "can_bus/routing_table.hpp"
 #include "can_bus/app_message.hpp"
 #include "can_bus/can_message.hpp"
+#include "can_bus/acceptance_filter.hpp"
+#include "can_bus/request_tracker.hpp"
+#include "can_bus/dispatch_profiler.hpp"
 
 #include "etl/unordered_map.h"
+#include "etl/flat_map.h"
+#include "etl/bitset.h"
+#include "etl/array.h"
 
 /**
  * @brief  Main hub for routing messages from CAN bus to correct receiver components of device
@@ -25,33 +31,66 @@
  *         When CAN bus message if supplied to it it will determine if this module is received and pass
  *              it to corresponding component for processing.
  *         Routing rules (which component should receive which message) are defined in Routing_table
+ *         Routing of application message is resolved by direct indexing of Dispatch_table (flash) by message type
+ *              and of receiver table by component code, no hashing is performed for each frame
+ *         Execution time of every handler is recorded by Dispatch_profiler
  */
 class Message_router {
 private:
 
     /**
-     * @brief Map of device components and their instances
-     *        Based on this map is determined on which received of component should be invoked
+     * @brief   Maximal value of component code which can be registered as receiver
      */
-    inline static etl::unordered_map<Codes::Component, Message_receiver *, 32> component_instances = {};
+    static constexpr uint32_t component_table_size = 256;
+
+    /**
+     * @brief Table of device components and their instances indexed directly by component code
+     *        Based on this table is determined on which received of component should be invoked
+     */
+    inline static etl::array<Message_receiver *, component_table_size> component_instances = {};
+
+    /**
+     * @brief  Mask of message types which are bypassing router, set when bypass is registered
+     *         Allows to check bypass by single bit test without lookup in bypass table
+     */
+    inline static etl::bitset<Message_type_count> bypass_mask;
 
     /**
      * @brief  Dynamic routing table for bypassing router and sending message directly to component
      *         Is used to receive messages from another module based on special function of module
      *              for example can be used by sensor module to receive info which will be on display
+     *         Searched only for message types marked in bypass_mask
      */
-    inline static etl::unordered_map<Codes::Message_type, Codes::Component, 32> bypass_routing_table = {};
+    inline static etl::flat_map<uint16_t, Codes::Component, 32> bypass_routing_table = {};
 
 public:
 
     /**
      * @brief   If message is determined for this module then will route this message to correct component for processing
+     *          Message is passed by reference directly from receive ring, it is not copied during routing
      *
-     * @param message   Message for routing
+     * @param message   Message for routing, standard frames (admin messages) are routed as CAN::Message
      * @return true     Message was routed to correct component
      * @return false    Message cannot be routed to any component (this module is not receiver of this message, or component is not registered in router)
      */
-    static bool Route(CAN::Message message);
+    static bool Route(Application_message const &message);
+
+    /**
+     * @brief   Find receiver of application message based on message type, bypass routes are considered
+     *
+     * @param message_type  Type of application message
+     * @param bypass        Set to true if message type is routed via bypass table (should not be filtered by target module)
+     * @return Message_receiver*    Receiver of message, nullptr if no receiver is registered for message type
+     */
+    static Message_receiver * Resolve(Codes::Message_type message_type, bool &bypass);
+
+    /**
+     * @brief   Get registered receiver of component
+     *
+     * @param component             Component code
+     * @return Message_receiver*    Receiver of component, nullptr if component is not registered
+     */
+    static Message_receiver * Receiver(Codes::Component component);
 
     /**
      * @brief   Register instance of component into router as receiver for message types defined in Routing_table
@@ -64,6 +103,7 @@ public:
     /**
      * @brief   Add message type and receiver to bypass list, and this types of messages
      *              will not be discarded abut forwarded to component
+     *          Message type is also accepted by acceptance filter of CAN bus
      *
      * @param message_type
      */
@@ -0,0 +1,108 @@
+#include "request_tracker.hpp"
+
+#include <algorithm>
+
+#include "modules/base_module.hpp"
+#include "threads/common_thread.hpp"
+#include "can_bus/acceptance_filter.hpp"
+#include "ticks.hpp"
+#include "logger.hpp"
+
+void Request_tracker::Init(){
+    if (lock == nullptr) {
+        lock = new fra::MutexStandard();
+    }
+}
+
+bool Request_tracker::Request(Application_message const &request, Codes::Message_type response_type, Callback callback, uint32_t timeout_ms){
+    if (lock == nullptr) {
+        Logger::Error("Request tracker is not initialized");
+        return false;
+    }
+
+    lock->Lock();
+    if (pending.full()) {
+        lock->Unlock();
+        Logger::Warning("Too many pending requests, {} not sent", Codes::to_string(request.Message_type()));
+        return false;
+    }
+
+    TickType_t deadline = xTaskGetTickCount() + cpp_freertos::Ticks::MsToTicks(timeout_ms);
+    pending.push_back({response_type, request.Module_type(), request.Instance_enumeration(), deadline, std::move(callback)});
+    lock->Unlock();
+
+    // Responses are sent with module of sender as target, so they would be rejected by filter
+    CAN::Acceptance_filter::Allow_message_type(response_type);
+
+    Application_message message = request;
+    Base_module::Send_CAN_message(message);
+
+    // Dispatcher must reevaluate time until next timeout
+    Common_thread * dispatcher = Base_module::Dispatcher();
+    if ((dispatcher != nullptr) and (dispatcher->GetHandle() != xTaskGetCurrentTaskHandle())) {
+        xTaskNotifyGive(dispatcher->GetHandle());
+    }
+    return true;
+}
+
+bool Request_tracker::Match(Application_message const &message){
+    // Fast path for most of messages, without locking
+    if ((lock == nullptr) or pending.empty()) {
+        return false;
+    }
+
+    lock->Lock();
+    auto entry = std::find_if(pending.begin(), pending.end(), [&message](Pending const &candidate){
+        return (candidate.response_type == message.Message_type()) and Sender_matches(candidate, message);
+    });
+
+    if (entry == pending.end()) {
+        lock->Unlock();
+        return false;
+    }
+
+    Callback callback = std::move(entry->callback);
+    pending.erase(entry);
+    lock->Unlock();
+
+    // Callback can issue new request, so it is invoked without lock
+    callback(message);
+    return true;
+}
+
+TickType_t Request_tracker::Service(){
+    if (lock == nullptr) {
+        return portMAX_DELAY;
+    }
+
+    TickType_t wait = portMAX_DELAY;
+
+    while (true) {
+        TickType_t now = xTaskGetTickCount();
+        lock->Lock();
+        auto expired = std::find_if(pending.begin(), pending.end(), [now](Pending const &entry){
+            return static_cast<int32_t>(now - entry.deadline) >= 0;
+        });
+
+        if (expired == pending.end()) {
+            for (auto const &entry : pending) {
+                wait = std::min<TickType_t>(wait, entry.deadline - now);
+            }
+            lock->Unlock();
+            return wait;
+        }
+
+        Logger::Debug("Request for {} timed out", Codes::to_string(expired->response_type));
+        Callback callback = std::move(expired->callback);
+        pending.erase(expired);
+        lock->Unlock();
+
+        callback(std::nullopt);
+    }
+}
+
+bool Request_tracker::Sender_matches(Pending const &entry, Application_message const &message){
+    bool module_matches = (entry.module == Codes::Module::All) or (entry.module == Codes::Module::Any) or (entry.module == message.Module_type());
+    bool instance_matches = (entry.instance == Codes::Instance::All) or (entry.instance == message.Instance_enumeration());
+    return module_matches and instance_matches;
+}
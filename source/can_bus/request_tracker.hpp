@@ -0,0 +1,109 @@
+/**
+ * @file request_tracker.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <stdint.h>
+
+#include "codes/codes.hpp"
+#include "can_bus/app_message.hpp"
+
+#include "etl/vector.h"
+
+#include "mutex.hpp"
+#include "FreeRTOS.h"
+#include "task.h"
+
+namespace fra = cpp_freertos;
+
+/**
+ * @brief   Correlation of requests sent to other modules with their responses
+ *          Component sends request together with callback, response is matched by its type and by module and instance
+ *              which sent it (target of request), callback is then invoked with response right after it is received
+ *          When response does not arrive within timeout callback is invoked without response
+ *          Matching is done by router before regular routing, so no bypass route has to be registered for response
+ *          Callbacks are executed by dispatcher thread (Common_thread) and must not block,
+ *              work which waits for hardware should be deferred via Component::Defer
+ */
+class Request_tracker {
+public:
+    /**
+     * @brief   Invoked with received response, or with empty optional when request timed out
+     */
+    using Callback = std::function<void(std::optional<Application_message> const &response)>;
+
+    /**
+     * @brief   Maximal number of requests waiting for response
+     */
+    static constexpr size_t max_pending = 16;
+
+private:
+    /**
+     * @brief   Request waiting for response
+     */
+    struct Pending {
+        Codes::Message_type response_type;
+        Codes::Module       module;
+        Codes::Instance     instance;
+        TickType_t          deadline;
+        Callback            callback;
+    };
+
+    /**
+     * @brief   Requests waiting for response in order of sending
+     */
+    inline static etl::vector<Pending, max_pending> pending;
+
+    /**
+     * @brief   Requests can be sent from any thread, matching and timeouts are evaluated by dispatcher
+     */
+    inline static fra::MutexStandard * lock = nullptr;
+
+public:
+    /**
+     * @brief   Create synchronization primitives, must be called before first request
+     */
+    static void Init();
+
+    /**
+     * @brief   Send request to other module and register callback for its response
+     *          Response type is accepted by acceptance filter since first request
+     *
+     * @param request       Request to send, target module and instance are used to match response
+     * @param response_type Type of message which is expected as response
+     * @param callback      Invoked with response or with empty optional after timeout
+     * @param timeout_ms    Maximal time to wait for response
+     * @return true         Request was sent and is waiting for response
+     * @return false        Too many requests are waiting for response, callback will not be invoked
+     */
+    static bool Request(Application_message const &request, Codes::Message_type response_type, Callback callback, uint32_t timeout_ms = 500);
+
+    /**
+     * @brief   Match received message with oldest request waiting for it and invoke its callback
+     *          Called by router for every received application message
+     *
+     * @param message   Received message
+     * @return true     Message was response to pending request and was consumed
+     * @return false    Message is not awaited response, should be routed regularly
+     */
+    static bool Match(Application_message const &message);
+
+    /**
+     * @brief   Invoke callbacks of timed out requests, must be called from dispatcher thread
+     *
+     * @return TickType_t   Time until next request times out, portMAX_DELAY when there is no pending request
+     */
+    static TickType_t Service();
+
+private:
+    /**
+     * @brief   Check if response was sent by target of request, broadcast request matches any sender
+     */
+    static bool Sender_matches(Pending const &entry, Application_message const &message);
+};
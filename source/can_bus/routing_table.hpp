@@ -5,8 +5,12 @@
  * @date 14.08.2024
  */
 
+#pragma once
+
 #include "codes/codes.hpp"
 #include <unordered_map>
+#include <array>
+#include <stdint.h>
 
 /**
  * @brief   Routing table for General/Admin messages (messages with 11-bit identifier)
@@ -20,12 +24,33 @@ inline static const std::unordered_map<Codes::Command_admin, Codes::Component> A
     { Codes::Command_admin::Serial_port_confirmation, Codes::Component::CAN_serial },
 };
 
+/**
+ * @brief   Record of routing table, assigns message type to component which should receive it
+ */
+struct Route_record {
+    Codes::Message_type message_type;
+    Codes::Component    component;
+};
+
+/**
+ * @brief   Entry of dispatch table, routed flag is false for message types without receiving component
+ */
+struct Dispatch_entry {
+    Codes::Component    component;
+    bool                routed = false;
+};
+
+/**
+ * @brief   Number of application message types, message type is 12 bit field of identifier
+ */
+inline constexpr uint32_t Message_type_count = 4096;
+
 /**
  * @brief   Routing table for application messages (messages with 29-bit identifier)
  *          Contains type of message and component which should receive this message
- *          STL version of unordered_map is used because ETL is not placed into flash memory
+ *          Used only as source for Dispatch_table which is generated during compilation
  */
-inline static const std::unordered_map<Codes::Message_type, Codes::Component> Routing_table = {
+inline constexpr auto Routing_table = std::to_array<Route_record>({
     // Common core
     { Codes::Message_type::Device_reset,                               Codes::Component::Common_core        },
     { Codes::Message_type::Device_usb_bootloader,                      Codes::Component::Common_core        },
@@ -39,8 +64,20 @@ inline static const std::unordered_map<Codes::Message_type, Codes::Component> Ro
     { Codes::Message_type::Core_fw_hash_request,                       Codes::Component::Common_core        },
     { Codes::Message_type::Core_fw_dirty_request,                      Codes::Component::Common_core        },
     { Codes::Message_type::Core_hw_version_request,                    Codes::Component::Common_core        },
+    { Codes::Message_type::Core_can_statistics_request,                Codes::Component::Common_core        },
+    { Codes::Message_type::Core_dispatch_statistics_request,           Codes::Component::Common_core        },
+    { Codes::Message_type::Telemetry_subscribe_request,                Codes::Component::Common_core        },
+    { Codes::Message_type::Multi_get_request,                          Codes::Component::Common_core        },
+    { Codes::Message_type::Latency_probe_request,                      Codes::Component::Common_core        },
+    { Codes::Message_type::Latency_histogram_request,                  Codes::Component::Common_core        },
+    { Codes::Message_type::Time_sync,                                  Codes::Component::Common_core        },
+    { Codes::Message_type::Time_sync_follow_up,                        Codes::Component::Common_core        },
+    { Codes::Message_type::Segmented_transfer_first,                   Codes::Component::Common_core        },
+    { Codes::Message_type::Segmented_transfer_consecutive,             Codes::Component::Common_core        },
+    { Codes::Message_type::Segmented_transfer_flow_control,            Codes::Component::Common_core        },
     // LED panel
     { Codes::Message_type::LED_set_intensity,                          Codes::Component::LED_panel          },
+    { Codes::Message_type::LED_set_intensity_batch,                    Codes::Component::LED_panel          },
     { Codes::Message_type::LED_get_intensity_request,                  Codes::Component::LED_panel          },
     { Codes::Message_type::LED_get_temperature_request,                Codes::Component::LED_panel          },
     // Heater
@@ -91,6 +128,10 @@ inline static const std::unordered_map<Codes::Message_type, Codes::Component> Ro
     { Codes::Message_type::Fluorometer_OJIP_capture_request,           Codes::Component::Fluorometer        },
     { Codes::Message_type::Fluorometer_OJIP_completed_request,         Codes::Component::Fluorometer        },
     { Codes::Message_type::Fluorometer_OJIP_retrieve_request,          Codes::Component::Fluorometer        },
+    { Codes::Message_type::Fluorometer_OJIP_retrieve_packed_request,   Codes::Component::Fluorometer        },
+    { Codes::Message_type::Fluorometer_OJIP_capture_options_request,   Codes::Component::Fluorometer        },
+    { Codes::Message_type::Fluorometer_OJIP_bin_counts_request,        Codes::Component::Fluorometer        },
+    { Codes::Message_type::Fluorometer_OJIP_parameters_request,        Codes::Component::Fluorometer        },
     { Codes::Message_type::Fluorometer_emitor_temperature_request,     Codes::Component::Fluorometer        },
     { Codes::Message_type::Fluorometer_detector_temperature_request,   Codes::Component::Fluorometer        },
     { Codes::Message_type::Fluorometer_detector_info_request,          Codes::Component::Fluorometer        },
@@ -105,12 +146,35 @@ inline static const std::unordered_map<Codes::Message_type, Codes::Component> Ro
     // Pumps
     { Codes::Message_type::Pumps_pump_count_request,                   Codes::Component::Pumps              },
     { Codes::Message_type::Pumps_set_speed,                            Codes::Component::Pumps              },
+    { Codes::Message_type::Pumps_set_speed_batch,                      Codes::Component::Pumps              },
     { Codes::Message_type::Pumps_get_speed_request,                    Codes::Component::Pumps              },
     { Codes::Message_type::Pumps_set_flowrate,                         Codes::Component::Pumps              },
+    { Codes::Message_type::Pumps_set_flowrate_batch,                   Codes::Component::Pumps              },
     { Codes::Message_type::Pumps_get_flowrate_request,                 Codes::Component::Pumps              },
     { Codes::Message_type::Pumps_move,                                 Codes::Component::Pumps              },
     { Codes::Message_type::Pumps_stop,                                 Codes::Component::Pumps              },
     { Codes::Message_type::Pumps_stop_all,                             Codes::Component::Pumps              },
     { Codes::Message_type::Pumps_info_request,                         Codes::Component::Pumps              },
     { Codes::Message_type::Pumps_set_max_flowrate,                     Codes::Component::Pumps              },
-};
+});
+
+/**
+ * @brief   Generate dispatch table directly indexed by message type from routing records
+ *
+ * @param records   Routing records, message type and receiving component
+ * @return std::array<Dispatch_entry, Message_type_count>   Dispatch table with entry for every message type
+ */
+template <size_t N>
+constexpr std::array<Dispatch_entry, Message_type_count> Generate_dispatch_table(std::array<Route_record, N> const &records){
+    std::array<Dispatch_entry, Message_type_count> table = {};
+    for (auto const &record : records) {
+        table[static_cast<uint32_t>(record.message_type) & (Message_type_count - 1)] = {record.component, true};
+    }
+    return table;
+}
+
+/**
+ * @brief   Dispatch table for application messages, indexed directly by 12 bit message type
+ *          Generated during compilation and placed into flash memory, routing does not require any hashing
+ */
+inline constexpr std::array<Dispatch_entry, Message_type_count> Dispatch_table = Generate_dispatch_table(Routing_table);
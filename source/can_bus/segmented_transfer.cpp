@@ -0,0 +1,266 @@
+#include "segmented_transfer.hpp"
+
+#include <algorithm>
+
+#include "modules/base_module.hpp"
+#include "can_bus/message_router.hpp"
+#include "rtos/wrappers.hpp"
+#include "logger.hpp"
+
+void Segmented_transfer::Init(){
+    if (transmit_mutex == nullptr) {
+        transmit_mutex = new fra::MutexStandard();
+        flow_control = new fra::BinarySemaphore();
+    }
+}
+
+bool Segmented_transfer::Send(Codes::Module module, Codes::Instance instance, Codes::Component component, std::span<const uint8_t> payload, uint32_t timeout_ms){
+    if (payload.size() > max_payload_size) {
+        Logger::Error("Segmented transfer payload too large: {}", payload.size());
+        return false;
+    }
+
+    if (module == Codes::Module::All or module == Codes::Module::Any or instance == Codes::Instance::All) {
+        Logger::Error("Segmented transfer requires specific target module");
+        return false;
+    }
+
+    transmit_mutex->Lock();
+
+    peer_module = module;
+    peer_instance = instance;
+    // Clear flow control left from previous transfer
+    flow_control->Take(0);
+
+    uint8_t source_module = static_cast<uint8_t>(Base_module::Module_type());
+    uint8_t source_instance = static_cast<uint8_t>(Base_module::Instance_enumeration()) << 4;
+
+    etl::vector<uint8_t, 8> first_frame = {
+        source_module,
+        source_instance,
+        static_cast<uint8_t>(component),
+        static_cast<uint8_t>(payload.size() >> 8),
+        static_cast<uint8_t>(payload.size()),
+    };
+    size_t offset = std::min<size_t>(payload.size(), first_frame_payload);
+    first_frame.insert(first_frame.end(), payload.begin(), payload.begin() + offset);
+
+    bool success = Base_module::Send_CAN_message_blocking(
+        Application_message(module, instance, Codes::Message_type::Segmented_transfer_first, first_frame),
+        CAN::TX_priority::Normal, timeout_ms);
+
+    uint8_t sequence = 1;
+    TickType_t timeout = fra::Ticks::MsToTicks(timeout_ms);
+
+    while (success and offset < payload.size()) {
+        if (not flow_control->Take(timeout)) {
+            Logger::Warning("Segmented transfer flow control timeout");
+            success = false;
+            break;
+        }
+
+        if (peer_status == Flow_status::Abort) {
+            Logger::Warning("Segmented transfer aborted by receiver");
+            success = false;
+            break;
+        } else if (peer_status == Flow_status::Wait) {
+            continue;
+        }
+
+        uint8_t block_size = peer_block_size;
+        uint8_t separation_ms = peer_separation_ms;
+
+        for (uint8_t sent = 0; (offset < payload.size()) and (block_size == 0 or sent < block_size); sent++) {
+            etl::vector<uint8_t, 8> consecutive_frame = {
+                source_module,
+                static_cast<uint8_t>(source_instance | sequence),
+            };
+            size_t length = std::min<size_t>(payload.size() - offset, consecutive_frame_payload);
+            consecutive_frame.insert(consecutive_frame.end(), payload.begin() + offset, payload.begin() + offset + length);
+
+            if (not Base_module::Send_CAN_message_blocking(
+                    Application_message(module, instance, Codes::Message_type::Segmented_transfer_consecutive, consecutive_frame),
+                    CAN::TX_priority::Bulk, timeout_ms)) {
+                success = false;
+                break;
+            }
+
+            offset += length;
+            sequence = (sequence + 1) & 0x0f;
+
+            if (separation_ms) {
+                rtos::Delay(separation_ms);
+            }
+        }
+    }
+
+    peer_module = Codes::Module::Undefined;
+    peer_instance = Codes::Instance::Undefined;
+    transmit_mutex->Unlock();
+
+    return success;
+}
+
+bool Segmented_transfer::Receive(Application_message const &message){
+    if (message.data.size() < 2) {
+        Logger::Warning("Segmented transfer frame too short");
+        return false;
+    }
+
+    switch (message.Message_type()) {
+        case Codes::Message_type::Segmented_transfer_first:
+            return Receive_first_frame(message);
+
+        case Codes::Message_type::Segmented_transfer_consecutive:
+            return Receive_consecutive_frame(message);
+
+        case Codes::Message_type::Segmented_transfer_flow_control:
+            return Receive_flow_control(message);
+
+        default:
+            return false;
+    }
+}
+
+bool Segmented_transfer::Receive_first_frame(Application_message const &message){
+    if (message.data.size() < 5) {
+        Logger::Warning("Segmented transfer first frame too short");
+        return false;
+    }
+
+    Codes::Module module = static_cast<Codes::Module>(message.data[0]);
+    Codes::Instance instance = static_cast<Codes::Instance>(message.data[1] >> 4);
+    uint16_t length = (message.data[3] << 8) | message.data[4];
+
+    if (length > max_payload_size) {
+        Logger::Warning("Segmented transfer payload too large: {}", length);
+        Send_flow_control(module, instance, Flow_status::Abort);
+        return false;
+    }
+
+    TickType_t now = xTaskGetTickCount();
+
+    // Sender restarted transfer, previous one is discarded
+    Reassembly * reassembly = Find(module, instance);
+
+    if (reassembly == nullptr) {
+        if (reassemblies.full()) {
+            auto stale = std::find_if(reassemblies.begin(), reassemblies.end(), [now](Reassembly const &entry){
+                return (now - entry.last_activity) > fra::Ticks::MsToTicks(reassembly_timeout_ms);
+            });
+            if (stale == reassemblies.end()) {
+                Logger::Warning("Segmented transfer reassembly table full");
+                Send_flow_control(module, instance, Flow_status::Abort);
+                return false;
+            }
+            reassemblies.erase(stale);
+        }
+        reassemblies.emplace_back();
+        reassembly = &reassemblies.back();
+    }
+
+    reassembly->module = module;
+    reassembly->instance = instance;
+    reassembly->component = static_cast<Codes::Component>(message.data[2]);
+    reassembly->length = length;
+    reassembly->sequence = 1;
+    reassembly->block_remaining = receive_block_size;
+    reassembly->last_activity = now;
+    reassembly->buffer.assign(message.data.begin() + 5, message.data.begin() + 5 + std::min<size_t>(message.data.size() - 5, length));
+
+    if (reassembly->buffer.size() >= length) {
+        Deliver(*reassembly);
+        reassemblies.erase(reassemblies.begin() + std::distance(reassemblies.data(), reassembly));
+    } else {
+        Send_flow_control(module, instance, Flow_status::Continue);
+    }
+    return true;
+}
+
+bool Segmented_transfer::Receive_consecutive_frame(Application_message const &message){
+    Codes::Module module = static_cast<Codes::Module>(message.data[0]);
+    Codes::Instance instance = static_cast<Codes::Instance>(message.data[1] >> 4);
+    uint8_t sequence = message.data[1] & 0x0f;
+
+    Reassembly * reassembly = Find(module, instance);
+    if (reassembly == nullptr) {
+        Logger::Warning("Segmented transfer frame without first frame");
+        return false;
+    }
+
+    auto index = reassemblies.begin() + std::distance(reassemblies.data(), reassembly);
+
+    if (sequence != reassembly->sequence) {
+        Logger::Warning("Segmented transfer sequence mismatch, expected {} received {}", (short)reassembly->sequence, (short)sequence);
+        Send_flow_control(module, instance, Flow_status::Abort);
+        reassemblies.erase(index);
+        return false;
+    }
+
+    size_t length = std::min<size_t>(message.data.size() - 2, reassembly->length - reassembly->buffer.size());
+    reassembly->buffer.insert(reassembly->buffer.end(), message.data.begin() + 2, message.data.begin() + 2 + length);
+    reassembly->sequence = (reassembly->sequence + 1) & 0x0f;
+    reassembly->last_activity = xTaskGetTickCount();
+
+    if (reassembly->buffer.size() >= reassembly->length) {
+        Deliver(*reassembly);
+        reassemblies.erase(index);
+        return true;
+    }
+
+    if (--reassembly->block_remaining == 0) {
+        reassembly->block_remaining = receive_block_size;
+        Send_flow_control(module, instance, Flow_status::Continue);
+    }
+    return true;
+}
+
+bool Segmented_transfer::Receive_flow_control(Application_message const &message){
+    if (message.data.size() < 4) {
+        Logger::Warning("Segmented transfer flow control too short");
+        return false;
+    }
+
+    Codes::Module module = static_cast<Codes::Module>(message.data[0]);
+    Codes::Instance instance = static_cast<Codes::Instance>(message.data[1] >> 4);
+
+    if (module != peer_module or instance != peer_instance) {
+        Logger::Trace("Segmented transfer flow control from unexpected module");
+        return false;
+    }
+
+    peer_status = static_cast<Flow_status>(message.data[1] & 0x0f);
+    peer_block_size = message.data[2];
+    peer_separation_ms = message.data[3];
+    flow_control->Give();
+    return true;
+}
+
+void Segmented_transfer::Send_flow_control(Codes::Module module, Codes::Instance instance, Flow_status status){
+    etl::vector<uint8_t, 8> data = {
+        static_cast<uint8_t>(Base_module::Module_type()),
+        static_cast<uint8_t>((static_cast<uint8_t>(Base_module::Instance_enumeration()) << 4) | static_cast<uint8_t>(status)),
+        receive_block_size,
+        0,
+    };
+    Base_module::Send_CAN_message(Application_message(module, instance, Codes::Message_type::Segmented_transfer_flow_control, data));
+}
+
+void Segmented_transfer::Deliver(Reassembly const &reassembly){
+    Message_receiver * receiver = Message_router::Receiver(reassembly.component);
+    if (receiver == nullptr) {
+        Logger::Warning("Segmented transfer receiver component not registered");
+        return;
+    }
+
+    if (not receiver->Receive_segmented(reassembly.module, reassembly.instance, reassembly.buffer)) {
+        Logger::Warning("Segmented transfer payload not processed by component");
+    }
+}
+
+Segmented_transfer::Reassembly * Segmented_transfer::Find(Codes::Module module, Codes::Instance instance){
+    auto reassembly = std::find_if(reassemblies.begin(), reassemblies.end(), [module, instance](Reassembly const &entry){
+        return entry.module == module and entry.instance == instance;
+    });
+    return (reassembly != reassemblies.end()) ? &(*reassembly) : nullptr;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file segmented_transfer.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include <span>
+#include <stdint.h>
+
+#include "codes/codes.hpp"
+#include "can_bus/app_message.hpp"
+
+#include "etl/vector.h"
+
+#include "semaphore.hpp"
+#include "mutex.hpp"
+#include "ticks.hpp"
+
+/**
+ * @brief   Transport of payloads larger than 8 bytes over application messages (ISO-TP style)
+ *          Payload is split into first frame and consecutive frames, receiver controls pace of transfer by flow control frames
+ *          Data frames are addressed to target module and instance, flow control frames back to originator of transfer
+ *          Layout of frames (first two bytes identify sender of frame):
+ *              First frame:        [0] source module, [1] source instance (high nibble), [2] destination component,
+ *                                  [3-4] payload length (big-endian), [5-7] payload bytes 0-2
+ *              Consecutive frame:  [0] source module, [1] source instance (high nibble) and sequence number (low nibble),
+ *                                  [2-7] next 6 payload bytes
+ *              Flow control frame: [0] source module, [1] source instance (high nibble) and flow status (low nibble),
+ *                                  [2] block size (0 = unlimited), [3] separation time in ms
+ *          Completed payload is delivered to component via Message_receiver::Receive_segmented
+ */
+class Segmented_transfer {
+public:
+    /**
+     * @brief   State reported by receiver in flow control frame
+     */
+    enum class Flow_status: uint8_t {
+        Continue    = 0,
+        Wait        = 1,
+        Abort       = 2,
+    };
+
+    /**
+     * @brief   Maximal size of transferred payload
+     */
+    static constexpr uint16_t max_payload_size = 1024;
+
+private:
+    /**
+     * @brief   Payload bytes carried by first frame
+     */
+    static constexpr uint8_t first_frame_payload = 3;
+
+    /**
+     * @brief   Payload bytes carried by consecutive frame
+     */
+    static constexpr uint8_t consecutive_frame_payload = 6;
+
+    /**
+     * @brief   Number of consecutive frames which can be received before receiver sends next flow control frame
+     */
+    static constexpr uint8_t receive_block_size = 8;
+
+    /**
+     * @brief   Reassembly which did not receive any frame for this time can be replaced by new transfer
+     */
+    static constexpr uint32_t reassembly_timeout_ms = 1000;
+
+    /**
+     * @brief   State of payload received from one sender
+     */
+    struct Reassembly {
+        Codes::Module       module;
+        Codes::Instance     instance;
+        Codes::Component    component;
+        uint16_t            length;
+        uint8_t             sequence;
+        uint8_t             block_remaining;
+        TickType_t          last_activity;
+        etl::vector<uint8_t, max_payload_size> buffer;
+    };
+
+    /**
+     * @brief   Payloads which are currently received, one per sender
+     */
+    inline static etl::vector<Reassembly, 4> reassemblies;
+
+    /**
+     * @brief   Only one transfer can be transmitted at time, transfers of other threads wait for it
+     */
+    inline static fra::MutexStandard * transmit_mutex = nullptr;
+
+    /**
+     * @brief   Given when flow control frame from peer of current outgoing transfer is received
+     */
+    inline static fra::BinarySemaphore * flow_control = nullptr;
+
+    /**
+     * @brief   Peer of current outgoing transfer, flow control frames from other modules are ignored
+     */
+    inline static Codes::Module peer_module = Codes::Module::Undefined;
+    inline static Codes::Instance peer_instance = Codes::Instance::Undefined;
+
+    /**
+     * @brief   Content of last flow control frame received from peer
+     */
+    inline static volatile Flow_status peer_status = Flow_status::Continue;
+    inline static volatile uint8_t peer_block_size = 0;
+    inline static volatile uint8_t peer_separation_ms = 0;
+
+public:
+    /**
+     * @brief   Create synchronization primitives of service, must be called before first transfer
+     */
+    static void Init();
+
+    /**
+     * @brief   Transmit payload to component of other module
+     *          Caller is blocked until whole payload is passed to CAN thread, flow control frames are processed
+     *              by dispatcher, so this must not be called from dispatcher thread (from Receive methods of components)
+     *
+     * @param module        Target module, must be specific module type (not All/Any)
+     * @param instance      Target instance of module
+     * @param component     Component of target module which receives payload
+     * @param payload       Transferred data, up to max_payload_size bytes
+     * @param timeout_ms    Maximal time to wait for each flow control frame
+     * @return true         Payload was transmitted
+     * @return false        Payload is too large, receiver aborted transfer or did not respond
+     */
+    static bool Send(Codes::Module module, Codes::Instance instance, Codes::Component component, std::span<const uint8_t> payload, uint32_t timeout_ms = 500);
+
+    /**
+     * @brief   Process received frame of segmented transfer (first, consecutive or flow control)
+     *
+     * @param message   Received frame
+     * @return true     Frame was processed
+     * @return false    Frame is malformed or does not belong to any transfer
+     */
+    static bool Receive(Application_message const &message);
+
+private:
+    /**
+     * @brief   Start new reassembly based on first frame
+     */
+    static bool Receive_first_frame(Application_message const &message);
+
+    /**
+     * @brief   Append consecutive frame to reassembly of its sender, deliver payload when complete
+     */
+    static bool Receive_consecutive_frame(Application_message const &message);
+
+    /**
+     * @brief   Store flow control parameters for transmitting thread and wake it
+     */
+    static bool Receive_flow_control(Application_message const &message);
+
+    /**
+     * @brief   Send flow control frame to originator of transfer
+     *
+     * @param module    Module which originated transfer
+     * @param instance  Instance of module which originated transfer
+     * @param status    State of receiver
+     */
+    static void Send_flow_control(Codes::Module module, Codes::Instance instance, Flow_status status);
+
+    /**
+     * @brief   Pass completed payload to destination component
+     *
+     * @param reassembly    Completed reassembly
+     */
+    static void Deliver(Reassembly const &reassembly);
+
+    /**
+     * @brief   Find reassembly of sender
+     *
+     * @return Reassembly*  Pointer to reassembly, nullptr if sender has no transfer in progress
+     */
+    static Reassembly * Find(Codes::Module module, Codes::Instance instance);
+};
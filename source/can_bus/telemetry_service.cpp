@@ -0,0 +1,134 @@
+#include "telemetry_service.hpp"
+
+#include <algorithm>
+
+#include "modules/base_module.hpp"
+#include "can_bus/message_router.hpp"
+#include "ticks.hpp"
+#include "logger.hpp"
+
+bool Telemetry_service::Receive(Application_message const &message){
+    if (message.data.size() < 4) {
+        Logger::Warning("Telemetry subscription request too short");
+        return false;
+    }
+
+    auto request = static_cast<Codes::Message_type>((message.data[0] << 8) | message.data[1]);
+    uint32_t period_ms = (message.data[2] << 8) | message.data[3];
+    auto module = message.data.size() > 4 ? static_cast<Codes::Module>(message.data[4]) : Codes::Module::Undefined;
+    auto instance = message.data.size() > 5 ? static_cast<Codes::Instance>(message.data[5]) : Codes::Instance::Undefined;
+
+    auto subscription = std::find_if(subscriptions.begin(), subscriptions.end(), [request, module, instance](Subscription const &entry){
+        return (entry.request == request) and (entry.subscriber_module == module) and (entry.subscriber_instance == instance);
+    });
+
+    // Only subscription of requesting subscriber is cancelled, others keep receiving
+    if (period_ms == 0) {
+        if (subscription != subscriptions.end()) {
+            subscriptions.erase(subscription);
+            Logger::Debug("Telemetry subscription of {} cancelled", Codes::to_string(request));
+        }
+        return true;
+    }
+
+    TickType_t now = xTaskGetTickCount();
+    TickType_t period = cpp_freertos::Ticks::MsToTicks(std::max(period_ms, minimal_period_ms));
+    TickType_t expires = now + cpp_freertos::Ticks::MsToTicks(lease_ms);
+
+    if (subscription != subscriptions.end()) {
+        // Renewal keeps phase of pushes unless period changed
+        if (subscription->period != period) {
+            subscription->period = period;
+            subscription->next_due = now;
+        }
+        subscription->expires = expires;
+        return true;
+    }
+
+    if (subscriptions.full()) {
+        Logger::Warning("Telemetry subscription table full");
+        return false;
+    }
+
+    subscriptions.push_back({request, module, instance, period, now, expires});
+    Logger::Debug("Telemetry subscription of {} every {} ms", Codes::to_string(request), period_ms);
+    return true;
+}
+
+TickType_t Telemetry_service::Service(){
+    TickType_t now = xTaskGetTickCount();
+
+    // Remove subscriptions which were not renewed
+    auto expired = std::remove_if(subscriptions.begin(), subscriptions.end(), [now](Subscription const &entry){
+        return static_cast<int32_t>(now - entry.expires) >= 0;
+    });
+    subscriptions.erase(expired, subscriptions.end());
+
+    TickType_t wait = portMAX_DELAY;
+
+    for (auto &subscription : subscriptions) {
+        if (static_cast<int32_t>(now - subscription.next_due) >= 0) {
+            // Request is handled by component same way as request received from bus, component sends its response
+            Application_message request(Base_module::Module_type(), Base_module::Instance_enumeration(), subscription.request);
+            Message_router::Route(request);
+            subscription.next_due += subscription.period;
+            // Do not try to catch up missed periods
+            if (static_cast<int32_t>(now - subscription.next_due) >= 0) {
+                subscription.next_due = now + subscription.period;
+            }
+        }
+        wait = std::min<TickType_t>(wait, subscription.next_due - now);
+    }
+
+    return wait;
+}
+
+bool Telemetry_service::Subscribe(Codes::Module module, Codes::Instance instance, Codes::Message_type request, uint32_t period_ms){
+    uint16_t type = static_cast<uint16_t>(request);
+    uint16_t period = std::min<uint32_t>(period_ms, UINT16_MAX);
+
+    etl::vector<uint8_t, 8> data = {
+        static_cast<uint8_t>(type >> 8),
+        static_cast<uint8_t>(type),
+        static_cast<uint8_t>(period >> 8),
+        static_cast<uint8_t>(period),
+    };
+
+    if (Base_module::Singleton_instance() == nullptr) {
+        return false;
+    }
+
+    data.push_back(static_cast<uint8_t>(Base_module::Module_type()));
+    data.push_back(static_cast<uint8_t>(Base_module::Instance_enumeration()));
+
+    Application_message subscription(module, instance, Codes::Message_type::Telemetry_subscribe_request, data);
+    Base_module::Send_CAN_message(subscription);
+    return true;
+}
+
+Telemetry_subscription::Telemetry_subscription(Codes::Module module, Codes::Instance instance, Codes::Message_type request, uint32_t period_ms):
+    module(module),
+    instance(instance),
+    request(request),
+    period_ms(period_ms)
+{ }
+
+bool Telemetry_subscription::Renew(){
+    TickType_t now = xTaskGetTickCount();
+    if (renewed.has_value() and (now - renewed.value()) < cpp_freertos::Ticks::MsToTicks(Telemetry_service::lease_ms / 2)) {
+        return true;
+    }
+
+    if (not Telemetry_service::Subscribe(module, instance, request, period_ms)) {
+        return false;
+    }
+    renewed = now;
+    return true;
+}
+
+void Telemetry_subscription::Cancel(){
+    if (renewed.has_value()) {
+        Telemetry_service::Subscribe(module, instance, request, 0);
+        renewed.reset();
+    }
+}
@@ -0,0 +1,132 @@
+/**
+ * @file telemetry_service.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <optional>
+
+#include "codes/codes.hpp"
+#include "can_bus/app_message.hpp"
+
+#include "etl/vector.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief   Periodic push of responses to subscribed requests, replaces request/response polling of steady-state values
+ *          Subscriber sends Telemetry_subscribe_request with type of request and period, module then periodically
+ *              routes this request to its own component as if it was received from bus, so component sends its usual response
+ *          Subscription request data: [0-1] message type of request (big-endian), [2-3] period in ms (big-endian), period 0 cancels,
+ *              [4] module of subscriber, [5] instance of subscriber (optional, requests without them share one anonymous subscriber)
+ *          Subscriptions are kept per request type and subscriber, so subscribers do not change or cancel subscriptions of others
+ *          Subscriptions expire when not renewed within lease time, so subscribers of restarted or disconnected modules
+ *              do not generate traffic forever
+ *          Only requests without data can be subscribed
+ *          Service is executed by dispatcher thread (Common_thread), between processing of received messages
+ */
+class Telemetry_service {
+public:
+    /**
+     * @brief   Subscription is removed when it is not renewed within this time
+     */
+    static constexpr uint32_t lease_ms = 60000;
+
+    /**
+     * @brief   Shortest allowed period of subscription
+     */
+    static constexpr uint32_t minimal_period_ms = 100;
+
+private:
+    /**
+     * @brief   Record of single subscribed request
+     */
+    struct Subscription {
+        Codes::Message_type request;
+        Codes::Module       subscriber_module;
+        Codes::Instance     subscriber_instance;
+        TickType_t          period;
+        TickType_t          next_due;
+        TickType_t          expires;
+    };
+
+    /**
+     * @brief   Active subscriptions, one per request type and subscriber
+     */
+    inline static etl::vector<Subscription, 16> subscriptions;
+
+public:
+    /**
+     * @brief   Process subscription request received from bus
+     *
+     * @param message   Received Telemetry_subscribe_request
+     * @return true     Subscription was created, renewed or cancelled
+     * @return false    Request is malformed or subscription table is full
+     */
+    static bool Receive(Application_message const &message);
+
+    /**
+     * @brief   Execute all due subscriptions and remove expired ones
+     *          Must be called from dispatcher thread, responses are produced by components synchronously
+     *
+     * @return TickType_t   Time until next subscription is due, portMAX_DELAY when there is no subscription
+     */
+    static TickType_t Service();
+
+    /**
+     * @brief   Send subscription request to other module, this module is identified as subscriber
+     *
+     * @param module        Module which provides values
+     * @param instance      Instance of module which provides values
+     * @param request       Type of request which response should be pushed periodically
+     * @param period_ms     Period of pushed responses, 0 cancels subscription
+     * @return true         Subscription request was sent
+     * @return false        Subscription request cannot be sent
+     */
+    static bool Subscribe(Codes::Module module, Codes::Instance instance, Codes::Message_type request, uint32_t period_ms);
+};
+
+/**
+ * @brief   Subscription held by subscribing component, takes care of renewal of lease
+ */
+class Telemetry_subscription {
+private:
+    const Codes::Module         module;
+    const Codes::Instance       instance;
+    const Codes::Message_type   request;
+    const uint32_t              period_ms;
+
+    /**
+     * @brief   Time of last renewal, unset when subscription is not active
+     */
+    std::optional<TickType_t> renewed = std::nullopt;
+
+public:
+    /**
+     * @brief   Construct a new subscription, subscription is not sent until Renew is called
+     *
+     * @param module        Module which provides values
+     * @param instance      Instance of module which provides values
+     * @param request       Type of request which response should be pushed periodically
+     * @param period_ms     Period of pushed responses
+     */
+    Telemetry_subscription(Codes::Module module, Codes::Instance instance, Codes::Message_type request, uint32_t period_ms);
+
+    /**
+     * @brief   Send subscription if it is not active or if half of lease elapsed, can be called as often as needed
+     *
+     * @return true     Subscription is active
+     * @return false    Subscription request cannot be sent
+     */
+    bool Renew();
+
+    /**
+     * @brief   Cancel subscription at providing module
+     */
+    void Cancel();
+};
@@ -0,0 +1,168 @@
+#include "time_sync.hpp"
+
+#include <cstdlib>
+
+#include "modules/base_module.hpp"
+#include "rtos/wrappers.hpp"
+#include "ticks.hpp"
+#include "logger.hpp"
+#include "config.hpp"
+
+#include "pico/time.h"
+
+void Time_sync::Init(){
+#ifdef CONFIG_TIME_SYNC_MASTER
+    if (master_broadcast == nullptr) {
+        master_broadcast = new rtos::Repeated_execution([](){ Broadcast(); }, sync_period_ms, true);
+        Logger::Notice("Time synchronization master started");
+    }
+#endif
+}
+
+bool Time_sync::Receive(Application_message const &message){
+    // Master keeps its own time, synchronization of other master is ignored
+    if (master_broadcast != nullptr) {
+        return true;
+    }
+
+    switch (message.Message_type()) {
+        case Codes::Message_type::Time_sync: {
+            if (message.data.size() < 1) {
+                Logger::Warning("Time sync without sequence number");
+                return false;
+            }
+            pending_sequence = message.data[0];
+            pending_receive_us = Application_message::Extend_timestamp(message.Receive_time(), time_us_64());
+            return true;
+        }
+
+        case Codes::Message_type::Time_sync_follow_up: {
+            if (message.data.size() < 8) {
+                Logger::Warning("Time sync follow-up too short");
+                return false;
+            }
+            // Follow-up of lost sync frame cannot be used
+            if ((not pending_receive_us.has_value()) or (message.data[0] != pending_sequence)) {
+                Logger::Debug("Time sync follow-up without sync frame");
+                return true;
+            }
+
+            uint64_t master_us = 0;
+            for (uint8_t index = 1; index < 8; index++) {
+                master_us = (master_us << 8) | message.data[index];
+            }
+
+            Update(pending_receive_us.value(), master_us);
+            pending_receive_us.reset();
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+std::optional<uint64_t> Time_sync::Now(){
+    return To_synchronized(time_us_64());
+}
+
+std::optional<uint64_t> Time_sync::To_synchronized(uint64_t local_us){
+    if (master_broadcast != nullptr) {
+        return local_us;
+    }
+
+    if (not Synchronized()) {
+        return std::nullopt;
+    }
+
+    int64_t elapsed_us = static_cast<int64_t>(local_us - reference_local_us);
+    int64_t correction_us = elapsed_us * drift_ppb / 1000000000;
+    return reference_master_us + elapsed_us + correction_us;
+}
+
+Time_sync::Status Time_sync::State(){
+    return {master_broadcast != nullptr, Synchronized(), drift_ppb, last_offset_us, synchronizations, steps};
+}
+
+bool Time_sync::Synchronized(){
+    if (not last_sync.has_value()) {
+        return false;
+    }
+    return (xTaskGetTickCount() - last_sync.value()) < cpp_freertos::Ticks::MsToTicks(validity_ms);
+}
+
+void Time_sync::Update(uint64_t local_us, uint64_t master_us){
+    std::optional<uint64_t> predicted_us = To_synchronized(local_us);
+    int64_t offset_us = predicted_us.has_value() ? static_cast<int64_t>(master_us - predicted_us.value()) : INT64_MAX;
+
+    if (std::llabs(offset_us) > step_threshold_us) {
+        // First synchronization, restart of master or lost synchronization
+        if (predicted_us.has_value()) {
+            Logger::Warning("Time sync offset {} us, clock stepped", offset_us);
+        } else {
+            Logger::Notice("Time synchronized");
+        }
+        drift_ppb = 0;
+        drift_initialized = false;
+        last_offset_us = 0;
+        steps++;
+    } else {
+        int64_t local_interval_us = static_cast<int64_t>(local_us - reference_local_us);
+        int64_t master_interval_us = static_cast<int64_t>(master_us - reference_master_us);
+        if (local_interval_us > 0) {
+            int32_t measured_ppb = static_cast<int32_t>((master_interval_us - local_interval_us) * 1000000000 / local_interval_us);
+            if (drift_initialized) {
+                // Exponential filter suppresses jitter of interrupt latency
+                drift_ppb += (measured_ppb - drift_ppb) / 8;
+            } else {
+                drift_ppb = measured_ppb;
+                drift_initialized = true;
+            }
+        }
+        last_offset_us = static_cast<int32_t>(offset_us);
+    }
+
+    reference_local_us = local_us;
+    reference_master_us = master_us;
+    last_sync = xTaskGetTickCount();
+    synchronizations++;
+
+    Logger::Trace("Time sync offset {} us, drift {} ppb", last_offset_us, drift_ppb);
+}
+
+void Time_sync::Broadcast(){
+    CAN_thread * can_thread = Base_module::CAN_manager();
+    if (can_thread == nullptr) {
+        return;
+    }
+
+    master_sequence++;
+    Application_message sync(Codes::Module::All, Codes::Instance::All, Codes::Message_type::Time_sync, {master_sequence});
+
+    can_thread->Timestamp_transmit(sync);
+    Base_module::Send_CAN_message(sync);
+
+    // Wait until frame leaves peripheral, time of transmission is captured in TX interrupt
+    std::optional<uint32_t> transmit_us = std::nullopt;
+    for (uint8_t attempt = 0; attempt < 20; attempt++) {
+        transmit_us = can_thread->Transmit_timestamp();
+        if (transmit_us.has_value()) {
+            break;
+        }
+        rtos::Delay(1);
+    }
+
+    if (not transmit_us.has_value()) {
+        Logger::Warning("Time sync frame was not transmitted");
+        return;
+    }
+
+    uint64_t master_us = Application_message::Extend_timestamp(transmit_us.value(), time_us_64());
+    etl::vector<uint8_t, 8> data = {master_sequence};
+    for (int8_t shift = 48; shift >= 0; shift -= 8) {
+        data.push_back(static_cast<uint8_t>(master_us >> shift));
+    }
+
+    Application_message follow_up(Codes::Module::All, Codes::Instance::All, Codes::Message_type::Time_sync_follow_up, data);
+    Base_module::Send_CAN_message(follow_up);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file time_sync.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include <optional>
+#include <stdint.h>
+
+#include "codes/codes.hpp"
+#include "can_bus/app_message.hpp"
+
+#include "rtos/repeated_execution.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief   Synchronization of time of modules to clock of master (usually core module), two-step protocol similar to PTP
+ *          Master periodically broadcasts Time_sync frame and captures time of its transmission in TX interrupt,
+ *              then broadcasts Time_sync_follow_up frame which carries this time
+ *          Other modules capture time of reception of Time_sync frame in RX interrupt, so both timestamps refer to end of same frame
+ *              and transmission delay of frame or queueing in firmware does not affect synchronization
+ *          Rate difference (drift) of local clock against master is estimated from consecutive synchronizations,
+ *              so synchronized time is extrapolated between synchronizations
+ *          Time_sync data:             [0] sequence number
+ *          Time_sync_follow_up data:   [0] sequence number, [1-7] time of transmission of Time_sync in us of master (big-endian)
+ */
+class Time_sync {
+public:
+    /**
+     * @brief   Period of synchronization broadcast of master
+     */
+    static constexpr uint32_t sync_period_ms = 1000;
+
+    /**
+     * @brief   Offset larger than this is not corrected gradually, clock is stepped and drift estimation restarts
+     */
+    static constexpr uint32_t step_threshold_us = 1000;
+
+    /**
+     * @brief   Synchronized time is not provided when no synchronization was received within this time
+     */
+    static constexpr uint32_t validity_ms = 5 * sync_period_ms;
+
+    /**
+     * @brief   State of synchronization
+     */
+    struct Status {
+        bool        master;
+        bool        synchronized;
+        int32_t     drift_ppb;          // Rate difference of local clock against master in parts per billion
+        int32_t     last_offset_us;     // Difference of master time and extrapolated time at last synchronization
+        uint32_t    synchronizations;
+        uint32_t    steps;
+    };
+
+private:
+    /**
+     * @brief   Sequence number and local time of reception of last Time_sync frame waiting for follow-up
+     */
+    inline static uint8_t pending_sequence = 0;
+    inline static std::optional<uint64_t> pending_receive_us = std::nullopt;
+
+    /**
+     * @brief   Pair of local and master time from last synchronization, used as reference of extrapolation
+     */
+    inline static uint64_t reference_local_us = 0;
+    inline static uint64_t reference_master_us = 0;
+
+    /**
+     * @brief   Estimated drift of local clock, positive when master clock runs faster
+     */
+    inline static int32_t drift_ppb = 0;
+
+    /**
+     * @brief   Drift estimation is initialized by first measurement, then filtered
+     */
+    inline static bool drift_initialized = false;
+
+    /**
+     * @brief   Tick of last synchronization, empty before first one
+     */
+    inline static std::optional<TickType_t> last_sync = std::nullopt;
+
+    inline static int32_t last_offset_us = 0;
+    inline static uint32_t synchronizations = 0;
+    inline static uint32_t steps = 0;
+
+    /**
+     * @brief   Sequence number of last broadcast of master
+     */
+    inline static uint8_t master_sequence = 0;
+
+    /**
+     * @brief   Periodic broadcast of synchronization, exists only when module is master
+     */
+    inline static rtos::Repeated_execution * master_broadcast = nullptr;
+
+public:
+    /**
+     * @brief   Start periodic broadcast when module is configured as master of time
+     */
+    static void Init();
+
+    /**
+     * @brief   Process Time_sync or Time_sync_follow_up frame
+     *
+     * @param message   Received frame
+     * @return true     Frame was processed
+     * @return false    Frame is malformed
+     */
+    static bool Receive(Application_message const &message);
+
+    /**
+     * @brief   Current synchronized time
+     *
+     * @return std::optional<uint64_t>  Time of master in us, empty when module is not synchronized
+     */
+    static std::optional<uint64_t> Now();
+
+    /**
+     * @brief   Convert local timestamp (from time_us_64) to synchronized time
+     *
+     * @param local_us                  Local time in us
+     * @return std::optional<uint64_t>  Time of master in us, empty when module is not synchronized
+     */
+    static std::optional<uint64_t> To_synchronized(uint64_t local_us);
+
+    /**
+     * @brief   Current state of synchronization
+     */
+    static Status State();
+
+private:
+    /**
+     * @brief   Check if synchronization was received within validity time
+     */
+    static bool Synchronized();
+
+    /**
+     * @brief   Correct reference and drift estimation by new pair of timestamps
+     *
+     * @param local_us  Local time of reception of Time_sync frame
+     * @param master_us Master time of transmission of same frame
+     */
+    static void Update(uint64_t local_us, uint64_t master_us);
+
+    /**
+     * @brief   Broadcast Time_sync and its follow-up, executed periodically on master
+     */
+    static void Broadcast();
+};
@@ -0,0 +1,123 @@
+/**
+ * @file token_bucket.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <stdint.h>
+
+namespace CAN {
+
+/**
+ * @brief   Token bucket limiting share of bus bandwidth used by class of outgoing messages
+ *          Tokens are bits of bus time, bucket is refilled continuously by given rate and holds up to burst size
+ *          Frame can be transmitted only when bucket contains at least nominal number of bits of frame
+ *          Tokens are kept in bit-microseconds, so refill does not lose fractions of bits
+ */
+class Token_bucket {
+private:
+    /**
+     * @brief   Refill rate in bits per second, 0 means unlimited bucket
+     */
+    uint32_t rate_bps = 0;
+
+    /**
+     * @brief   Maximal content of bucket in bit-microseconds
+     */
+    uint64_t capacity = 0;
+
+    /**
+     * @brief   Current content of bucket in bit-microseconds
+     */
+    uint64_t tokens = 0;
+
+    /**
+     * @brief   Time of last refill in microseconds
+     */
+    uint32_t last_refill_us = 0;
+
+public:
+    /**
+     * @brief   Construct unlimited bucket
+     */
+    Token_bucket() = default;
+
+    /**
+     * @brief   Construct bucket with given rate, bucket starts full
+     *
+     * @param rate_bps      Refill rate in bits per second, 0 means unlimited bucket
+     * @param burst_bits    Maximal number of bits which can be transmitted at once after idle period
+     * @param now_us        Current time in microseconds
+     */
+    Token_bucket(uint32_t rate_bps, uint32_t burst_bits, uint32_t now_us):
+        rate_bps(rate_bps),
+        capacity(static_cast<uint64_t>(burst_bits) * 1000000),
+        tokens(capacity),
+        last_refill_us(now_us)
+    { }
+
+    /**
+     * @brief   Check if bucket limits rate
+     */
+    bool Unlimited() const {
+        return rate_bps == 0;
+    }
+
+    /**
+     * @brief   Take tokens for transmission of frame if bucket contains enough of them
+     *
+     * @param bits      Nominal length of frame in bits
+     * @param now_us    Current time in microseconds
+     * @return true     Tokens were taken, frame can be transmitted
+     * @return false    Not enough tokens, frame must wait
+     */
+    bool Consume(uint32_t bits, uint32_t now_us){
+        if (Unlimited()) {
+            return true;
+        }
+        Refill(now_us);
+        uint64_t required = static_cast<uint64_t>(bits) * 1000000;
+        if (tokens < required) {
+            return false;
+        }
+        tokens -= required;
+        return true;
+    }
+
+    /**
+     * @brief   Time until bucket contains enough tokens for frame
+     *
+     * @param bits      Nominal length of frame in bits
+     * @param now_us    Current time in microseconds
+     * @return uint32_t Time in microseconds, 0 if frame can be transmitted now
+     */
+    uint32_t Time_to_available(uint32_t bits, uint32_t now_us){
+        if (Unlimited()) {
+            return 0;
+        }
+        Refill(now_us);
+        uint64_t required = static_cast<uint64_t>(bits) * 1000000;
+        if (tokens >= required) {
+            return 0;
+        }
+        return static_cast<uint32_t>((required - tokens + rate_bps - 1) / rate_bps);
+    }
+
+private:
+    /**
+     * @brief   Add tokens for time elapsed since last refill
+     *
+     * @param now_us    Current time in microseconds
+     */
+    void Refill(uint32_t now_us){
+        uint32_t elapsed_us = now_us - last_refill_us;
+        last_refill_us = now_us;
+        tokens = std::min(capacity, tokens + static_cast<uint64_t>(elapsed_us) * rate_bps);
+    }
+};
+
+};
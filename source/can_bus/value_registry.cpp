@@ -0,0 +1,121 @@
+#include "value_registry.hpp"
+
+#include <bit>
+#include <limits>
+
+#include "modules/base_module.hpp"
+#include "threads/job_executor.hpp"
+#include "logger.hpp"
+
+#include "pico/time.h"
+
+void Value_registry::Register(Value_id id, Codes::Component owner, Getter getter){
+    if (entries[static_cast<uint8_t>(id)].getter) {
+        Logger::Warning("Value {} already registered, overwriting", static_cast<short>(id));
+    }
+    entries[static_cast<uint8_t>(id)] = {owner, getter};
+}
+
+std::optional<float> Value_registry::Read(Value_id id){
+    Getter const &getter = entries[static_cast<uint8_t>(id)].getter;
+    if (not getter) {
+        return std::nullopt;
+    }
+    return getter();
+}
+
+bool Value_registry::Receive(Application_message const &message){
+    if (message.data.empty()) {
+        Logger::Warning("Multi get request without values");
+        return false;
+    }
+
+    Multi_get request;
+    request.ids.assign(message.data.begin(), message.data.end());
+    request.origin = Dispatch_profiler::Defer_origin();
+    if (request.origin.has_value()) {
+        request.origin->completes = false;
+    }
+    Continue(std::move(request));
+    return true;
+}
+
+void Value_registry::Continue(Multi_get request){
+    while (request.values.size() < request.ids.size()) {
+        uint8_t id = request.ids[request.values.size()];
+        Entry const &entry = entries[id];
+
+        if (entry.getter) {
+            // Job continues with next value, so values are read sequentially and request is never shared between workers
+            bool submitted = Job_executor::Submit(entry.owner, [request, id]() mutable {
+                request.values.push_back(Read(static_cast<Value_id>(id)).value_or(std::numeric_limits<float>::quiet_NaN()));
+                Continue(std::move(request));
+            }, request.origin);
+            if (submitted) {
+                return;
+            }
+            Logger::Warning("Value {} cannot be read, work queue of owner is full", static_cast<short>(id));
+        }
+
+        request.values.push_back(std::numeric_limits<float>::quiet_NaN());
+    }
+
+    Respond(request);
+    if (request.origin.has_value()) {
+        Dispatch_profiler::Record_completion(request.origin.value(), time_us_32());
+    }
+}
+
+void Value_registry::Respond(Multi_get const &request){
+    etl::vector<uint8_t, 8> response_data;
+
+    for (size_t index = 0; index < request.ids.size(); index++) {
+        uint16_t half = Half_float(request.values[index]);
+
+        response_data.push_back(request.ids[index]);
+        response_data.push_back(static_cast<uint8_t>(half >> 8));
+        response_data.push_back(static_cast<uint8_t>(half));
+
+        if (response_data.size() == 6) {
+            Base_module::Send_CAN_message(Application_message(Codes::Message_type::Multi_get_response, response_data));
+            response_data.clear();
+        }
+    }
+
+    if (not response_data.empty()) {
+        Base_module::Send_CAN_message(Application_message(Codes::Message_type::Multi_get_response, response_data));
+    }
+}
+
+uint16_t Value_registry::Half_float(float value){
+    uint32_t bits = std::bit_cast<uint32_t>(value);
+    uint16_t sign = (bits >> 16) & 0x8000;
+    int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xff) - 127 + 15;
+    uint32_t mantissa = bits & 0x7fffff;
+
+    // Infinity and NaN
+    if (((bits >> 23) & 0xff) == 0xff) {
+        return sign | 0x7c00 | (mantissa ? 0x0200 : 0);
+    }
+
+    // Overflow is saturated to infinity
+    if (exponent >= 0x1f) {
+        return sign | 0x7c00;
+    }
+
+    // Subnormal values and underflow to zero
+    if (exponent <= 0) {
+        if (exponent < -10) {
+            return sign;
+        }
+        mantissa |= 0x800000;
+        return sign | (mantissa >> (14 - exponent));
+    }
+
+    uint16_t half = sign | (exponent << 10) | (mantissa >> 13);
+    // Round to nearest, carry to exponent is valid result
+    if (mantissa & 0x1000) {
+        half++;
+    }
+    return half;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file value_registry.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <stdint.h>
+
+#include "codes/codes.hpp"
+#include "can_bus/app_message.hpp"
+#include "can_bus/dispatch_profiler.hpp"
+
+#include "etl/array.h"
+#include "etl/vector.h"
+
+/**
+ * @brief   Registry of readable values of module components, allows to read many values in one round trip
+ *          Components register getter of their values when created, Multi_get_request then names list of value IDs
+ *          Request data: up to 8 value IDs (1 byte each)
+ *          Response is burst of Multi_get_response frames, each carries up to two values:
+ *              [0] value ID, [1-2] value as IEEE 754 half precision float (big-endian), [3] value ID, [4-5] value
+ *          Values which are not registered in module or cannot be read are reported as NaN
+ *          Every value is read by job in work queue of its owning component, so getter never runs concurrently
+ *              with other jobs of that component, values are read one after another and response is sent by last job
+ */
+class Value_registry {
+public:
+    /**
+     * @brief   Identifiers of values which can be read via Multi_get_request
+     */
+    enum class Value_id : uint8_t {
+        Core_temperature            = 0x00,
+        Core_load                   = 0x01,
+        Board_temperature           = 0x02,
+        Heater_intensity            = 0x10,
+        Heater_target_temperature   = 0x11,
+        Heater_plate_temperature    = 0x12,
+        Bottle_temperature          = 0x18,
+        Bottle_top_temperature      = 0x19,
+        Bottle_bottom_temperature   = 0x1a,
+        Mixer_RPM                   = 0x20,
+        Aerator_flowrate            = 0x28,
+        Cuvette_pump_flowrate       = 0x29,
+        Pump_1_flowrate             = 0x30,
+        Pump_2_flowrate             = 0x31,
+        Pump_3_flowrate             = 0x32,
+        Pump_4_flowrate             = 0x33,
+        LED_panel_temperature       = 0x38,
+        LED_panel_power_draw        = 0x39,
+    };
+
+    /**
+     * @brief   Function returning current value, empty optional when value cannot be read
+     */
+    using Getter = std::function<std::optional<float>()>;
+
+private:
+    /**
+     * @brief   Registered value, getter is executed in work queue of owner
+     */
+    struct Entry {
+        Codes::Component    owner;
+        Getter              getter;
+    };
+
+    /**
+     * @brief   Values indexed directly by value ID
+     */
+    inline static etl::array<Entry, 256> entries = {};
+
+    /**
+     * @brief   Progress of Multi_get_request, passed from job to job
+     */
+    struct Multi_get {
+        etl::vector<uint8_t, 8> ids;
+        etl::vector<float, 8>   values;
+        std::optional<Dispatch_profiler::Origin> origin;   // Request is completed by last job, not by each read
+    };
+
+public:
+    /**
+     * @brief   Register getter of value, existing getter is overwritten
+     *
+     * @param id        Identifier of value
+     * @param owner     Component which owns hardware read by getter, getter is executed in its work queue
+     * @param getter    Function returning current value
+     */
+    static void Register(Value_id id, Codes::Component owner, Getter getter);
+
+    /**
+     * @brief   Read value via registered getter, must be called from work queue of owner of value
+     *
+     * @param id                    Identifier of value
+     * @return std::optional<float> Current value, empty when value is not registered or cannot be read
+     */
+    static std::optional<float> Read(Value_id id);
+
+    /**
+     * @brief   Process Multi_get_request, start reading of requested values, response is sent when all values are read
+     *
+     * @param message   Received request
+     * @return true     Reading of values was started
+     * @return false    Request contains no value ID
+     */
+    static bool Receive(Application_message const &message);
+
+    /**
+     * @brief   Convert float to IEEE 754 half precision (binary16), rounded to nearest
+     *
+     * @param value     Value to convert
+     * @return uint16_t Bits of half precision float
+     */
+    static uint16_t Half_float(float value);
+
+private:
+    /**
+     * @brief   Submit read of next value into work queue of its owner, or send response when all values are read
+     *          Values which are not registered or which read cannot be submitted are reported as NaN
+     *
+     * @param request   Requested value IDs and values read so far
+     */
+    static void Continue(Multi_get request);
+
+    /**
+     * @brief   Send values as burst of packed Multi_get_response frames
+     *
+     * @param request   Requested value IDs and their values
+     */
+    static void Respond(Multi_get const &request);
+};
@@ -0,0 +1,68 @@
+#include "virtual_bus.hpp"
+#include <algorithm>
+
+bool CAN::Virtual_bus::Transmit(struct can2040_msg *msg){
+    // Transmission is finished when frame is stored on receive side, same as for TX IRQ of physical bus
+    Deliver(*msg);
+
+    if ((timestamped_id != 0) and (msg->id == timestamped_id)) {
+        transmit_timestamp = time_us_32();
+        transmit_timestamp_valid = true;
+        timestamped_id = 0;
+    }
+    statistics.tx_frames++;
+    statistics.tx_bytes += msg->dlc;
+    statistics.bus_bits += Bus_statistics::Frame_bits(msg->dlc, msg->id & CAN2040_ID_EFF);
+    Emit(IRQ_type::TX);
+    return true;
+}
+
+bool CAN::Virtual_bus::Transmit(Message const &message){
+    can2040_msg msg = message.to_msg();
+    return Transmit(&msg);
+}
+
+bool CAN::Virtual_bus::Transmit_available(){
+    return true;
+}
+
+uint8_t CAN::Virtual_bus::Received_queue_size(){
+    return rx_ring.Size();
+}
+
+Application_message const * CAN::Virtual_bus::Receive() const {
+    return rx_ring.Front();
+}
+
+void CAN::Virtual_bus::Release(){
+    rx_ring.Pop();
+}
+
+void CAN::Virtual_bus::Deliver(can2040_msg const &msg){
+    // Bits of frame are already counted by transmission, frame was on bus only once
+    if (not (msg.id & CAN2040_ID_EFF)) {
+        return;
+    }
+
+    if (not Acceptance_filter::Accept(msg.id & 0x1fffffff)) {
+        statistics.rx_filtered++;
+        return;
+    }
+
+    Application_message * slot = rx_ring.Reserve();
+    if (slot == nullptr) {
+        statistics.rx_dropped++;
+        return;
+    }
+    slot->Decode(&msg, time_us_32());
+    rx_ring.Commit();
+
+    statistics.rx_frames++;
+    statistics.rx_bytes += msg.dlc;
+    statistics.rx_high_water = std::max(statistics.rx_high_water, rx_ring.Size());
+    if (receive_listener != nullptr) {
+        xTaskNotifyGive(receive_listener);
+    } else {
+        Emit(IRQ_type::RX);
+    }
+}
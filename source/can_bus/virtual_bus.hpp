@@ -0,0 +1,197 @@
+/**
+ * @file virtual_bus.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include <optional>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pico/time.h"
+
+#include "hal/irq/irq_capable.hpp"
+#include "rtos/wrappers.hpp"
+#include "can_message.hpp"
+#include "app_message.hpp"
+#include "acceptance_filter.hpp"
+#include "bus_statistics.hpp"
+#include "tools/spsc_ring.hpp"
+
+#include "logger.hpp"
+
+extern "C" {
+#include "can2040.h"
+}
+
+namespace CAN {
+
+/**
+ * @brief   Software implementation of CAN bus without physical peripheral, every transmitted frame is received back by same node
+ *          Provides same interface as CAN::Bus (Transmit, Receive, Wait_for_any) so it can be used by CAN_thread as drop-in backend
+ *          Allows to exercise CAN thread, router and components of module on board without transceiver or other nodes on bus,
+ *              for example module can send requests to itself from test thread
+ *          Limitations:
+ *              - Only one node can exist in firmware image, Base_module, Acceptance_filter and Message_router are static,
+ *                  so multiple modules cannot be simulated in one process by multiple instances of virtual bus
+ *              - Frames are not delivered to any other module, virtual bus cannot be connected to physical or host bus
+ *              - Timing of physical bus (arbitration, bit time) is not simulated, frame is received immediately after transmission
+ */
+class Virtual_bus : public IRQ_capable {
+public:
+    /**
+     * @brief Supported IRQ types for virtual bus, same as for CAN::Bus
+     */
+    enum class IRQ_type: uint8_t{
+        Any,
+        RX,
+        TX,
+        Error
+    };
+
+private:
+    /**
+     * @brief   Ring of received messages, same as in CAN::Bus
+     *          Frames are stored by thread which calls Transmit and consumed by CAN thread,
+     *              scheduler is cooperative so producers cannot interleave and ring is always accessed by one thread at time
+     */
+    SPSC_ring<Application_message, 64> rx_ring;
+
+    /**
+     * @brief Frame counters of this instance
+     */
+    Bus_statistics statistics;
+
+    /**
+     * @brief   Task notified when message is stored into receive ring
+     */
+    TaskHandle_t receive_listener = nullptr;
+
+    /**
+     * @brief   Identifier of frame (including can2040 flags) which time of transmission should be captured, 0 when not armed
+     */
+    volatile uint32_t timestamped_id = 0;
+
+    /**
+     * @brief   Time of transmission of armed frame (lower 32 bits of system timer), valid when timestamped_id was cleared
+     */
+    volatile uint32_t transmit_timestamp = 0;
+    volatile bool transmit_timestamp_valid = false;
+
+public:
+    /**
+     * @brief Construct a new Virtual bus object
+     */
+    Virtual_bus() = default;
+
+    /**
+     * @brief   Transmit message over virtual bus
+     *          Frame is received back by this node, TX IRQ is emitted after reception
+     *
+     * @param msg       "Legacy" message structure used by can2040 library
+     * @return true     Message was transmitted
+     * @return false    Message was not transmitted
+     */
+    bool Transmit(struct can2040_msg *msg);
+
+    /**
+     * @brief   Transmit message over virtual bus
+     *
+     * @param message   Message to be transmitted
+     * @return true     Message was transmitted
+     * @return false    Message was not transmitted
+     */
+    bool Transmit(Message const &message);
+
+    /**
+     * @brief   Check if virtual bus is available for transmitting new message, virtual bus has no transmit buffer
+     *
+     * @return true     Virtual bus is always ready
+     */
+    bool Transmit_available();
+
+    /**
+     * @brief   Returns oldest received message, message is not removed from receive ring
+     *
+     * @return Application_message const*   Oldest received message, nullptr if no message is waiting
+     */
+    Application_message const * Receive() const;
+
+    /**
+     * @brief   Remove oldest received message (obtained by Receive) from receive ring
+     */
+    void Release();
+
+    /**
+     * @brief   Returns number of messages in receive queue waiting for processing
+     *
+     * @return uint8_t  Number of messages in receive queue
+     */
+    uint8_t Received_queue_size();
+
+    /**
+     * @brief   Frame counters of this instance
+     *
+     * @return Bus_statistics const&    Counters of transmitted, received and dropped frames
+     */
+    Bus_statistics const & Stats() const { return statistics; };
+
+    /**
+     * @brief   Capture time of transmission of next frame with same identifier as message, previous timestamp is invalidated
+     *          Used by time synchronization master, transmission time is taken in TX interrupt same as receive time on other nodes
+     *
+     * @param message   Message which time of transmission should be captured
+     */
+    void Timestamp_transmit(Message const &message){
+        transmit_timestamp_valid = false;
+        timestamped_id = message.to_msg().id;
+    };
+
+    /**
+     * @brief   Time of transmission of frame armed by Timestamp_transmit
+     *
+     * @return std::optional<uint32_t>  Lower 32 bits of system timer in us, empty if frame was not transmitted yet
+     */
+    std::optional<uint32_t> Transmit_timestamp() const {
+        if (not transmit_timestamp_valid) {
+            return std::nullopt;
+        }
+        return transmit_timestamp;
+    };
+
+    /**
+     * @brief   Number of received messages dropped due to full receive ring
+     *
+     * @return uint32_t Number of dropped messages
+     */
+    uint32_t Dropped_messages() const { return statistics.rx_dropped; };
+
+    /**
+     * @brief   Number of received messages rejected by acceptance filter
+     *
+     * @return uint32_t Number of rejected messages
+     */
+    uint32_t Filtered_messages() const { return statistics.rx_filtered; };
+
+    /**
+     * @brief   Register task which is notified (task notification) when new message is received
+     *          When listener is registered, RX IRQ is not emitted anymore, same as in CAN::Bus
+     *
+     * @param task  Handle of task processing received messages
+     */
+    void Notify_on_receive(TaskHandle_t task){ receive_listener = task; };
+
+private:
+    /**
+     * @brief   Decode transmitted frame into receive ring and emit RX IRQ
+     *          Standard (11 bit) frames and frames rejected by acceptance filter are discarded same as in CAN::Bus
+     *
+     * @param msg   Received frame
+     */
+    void Deliver(can2040_msg const &msg);
+};
+};
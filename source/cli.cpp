@@ -1,5 +1,12 @@
 #include "cli.hpp"
 
+#include "modules/base_module.hpp"
+#include "threads/common_thread.hpp"
+#include "threads/job_executor.hpp"
+#include "can_bus/latency_probe.hpp"
+#include "can_bus/dispatch_profiler.hpp"
+#include "can_bus/time_sync.hpp"
+
 CLI_service::CLI_service():cli(new CLI(0, 256, 32,"\033[94m>\033[0m ")){
 
     auto status = [this]()->void {
@@ -15,6 +22,10 @@ CLI_service::CLI_service():cli(new CLI(0, 256, 32,"\033[94m>\033[0m ")){
     cli->Bind("bootloader", [this]()->void { Bootloader(); }, "Reboots MCU into bootloader mode for fw update");
     cli->Bind("restart", [this]()->void { Restart(); }, "Restart MCU using watchdog");
     cli->Bind("thread_statistics", [this]()->void { Thread_statistics(); }, "Print statistics of FreeRTOS threads");
+    cli->Bind("dispatch_statistics", [this]()->void { Dispatch_statistics(); }, "Print statistics of CAN message dispatching");
+    cli->Bind("can_statistics", [this]()->void { CAN_statistics(); }, "Print statistics of CAN bus and tx queues");
+    cli->Bind("latency_histograms", [this]()->void { Latency_histograms(); }, "Print histograms of latency probes");
+    cli->Bind("time_sync", [this]()->void { Time_synchronization(); }, "Print state of time synchronization");
 
     /**
      * @brief Service thread for CLI
@@ -69,3 +80,97 @@ void CLI_service::Thread_statistics() {
     // Print the runtime stats
     cli->Print(runTimeStats);
 }
+
+void CLI_service::Dispatch_statistics(){
+    Common_thread * dispatcher = Base_module::Dispatcher();
+    if (dispatcher == nullptr) {
+        cli->Print("Dispatcher not running\r\n");
+        return;
+    }
+
+    auto statistics = dispatcher->Statistics();
+    uint32_t latency_avg = statistics.dispatched ? statistics.latency_sum_us / statistics.dispatched : 0;
+    uint32_t latency_min = statistics.dispatched ? statistics.latency_min_us : 0;
+
+    std::string output = "";
+    output += emio::format("Wakeups: {}\r\n", statistics.wakeups);
+    output += emio::format("Idle wakeups: {}\r\n", statistics.idle_wakeups);
+    output += emio::format("Dispatched messages: {}\r\n", statistics.dispatched);
+    output += emio::format("Receive to dispatch latency: min {} us, avg {} us, max {} us\r\n", latency_min, latency_avg, statistics.latency_max_us);
+
+    auto jobs = Job_executor::Stats();
+    output += emio::format("Deferred jobs: submitted {}, executed {}, rejected {}\r\n", jobs.submitted, jobs.executed, jobs.rejected);
+
+    output += "Handlers (calls, handler min/avg/max us, receive to completion max us):\r\n";
+    for (auto const &profile : Dispatch_profiler::Profiles()) {
+        uint32_t handler_avg = profile.calls ? profile.handler_sum_us / profile.calls : 0;
+        uint32_t handler_min = profile.calls ? profile.handler_min_us : 0;
+        output += emio::format("  {}: {}, {}/{}/{}, {}\r\n", Codes::to_string(profile.type), profile.calls,
+                               handler_min, handler_avg, profile.handler_max_us, profile.completion.max_us);
+    }
+    if (Dispatch_profiler::Untracked() != 0) {
+        output += emio::format("  Untracked messages: {}\r\n", Dispatch_profiler::Untracked());
+    }
+    cli->Print(output);
+}
+
+void CLI_service::CAN_statistics(){
+    CAN_thread * can_thread = Base_module::CAN_manager();
+    if (can_thread == nullptr) {
+        cli->Print("CAN thread not running\r\n");
+        return;
+    }
+
+    auto bus = can_thread->Bus_statistics();
+    auto const &tx = can_thread->TX_stats();
+
+    std::string output = "";
+    output += emio::format("RX: {} frames, {} bytes, dropped {}, filtered {}, ring high-water {}\r\n",
+                           bus.rx_frames, bus.rx_bytes, bus.rx_dropped, bus.rx_filtered, bus.rx_high_water);
+    output += emio::format("TX: {} frames, {} bytes, immediate {}, from queue {}\r\n",
+                           bus.tx_frames, bus.tx_bytes, tx.immediate, tx.retransmits);
+    output += emio::format("TX dropped: emergency {}, normal {}, bulk {}\r\n", tx.dropped[0], tx.dropped[1], tx.dropped[2]);
+    output += emio::format("TX high-water: emergency {}, normal {}, bulk {}\r\n", tx.high_water[0], tx.high_water[1], tx.high_water[2]);
+    output += emio::format("TX throttled by bus share: normal {}, bulk {}\r\n", tx.throttled[1], tx.throttled[2]);
+    output += emio::format("Errors: {}\r\n", bus.errors);
+    output += emio::format("Bus utilization: {:.1f} %\r\n", can_thread->Bus_utilization() * 100.0f);
+    cli->Print(output);
+}
+
+void CLI_service::Latency_histograms(){
+    const std::pair<Latency_probe::Interval, const char *> intervals[] = {
+        {Latency_probe::Interval::Receive_to_dispatch, "Receive to dispatch"},
+        {Latency_probe::Interval::Dispatch_to_enqueue, "Dispatch to enqueue"},
+        {Latency_probe::Interval::Enqueue_to_transmit, "Enqueue to transmit"},
+    };
+
+    std::string output = "";
+    for (auto const &[interval, name] : intervals) {
+        auto const &histogram = Latency_probe::Histogram(interval);
+        output += emio::format("{} (max {} us):\r\n", name, histogram.max_us);
+        for (uint8_t bucket = 0; bucket < Latency_histogram::bucket_count; bucket++) {
+            if (histogram.counts[bucket] != 0) {
+                output += emio::format("  >= {} us: {}\r\n", Latency_histogram::Bucket_floor(bucket), histogram.counts[bucket]);
+            }
+        }
+    }
+    cli->Print(output);
+}
+
+void CLI_service::Time_synchronization(){
+    Time_sync::Status status = Time_sync::State();
+
+    std::string output = "";
+    output += emio::format("Role: {}\r\n", status.master ? "master" : "slave");
+    output += emio::format("Synchronized: {}\r\n", status.synchronized ? "yes" : "no");
+    if (not status.master) {
+        output += emio::format("Synchronizations: {}, steps: {}\r\n", status.synchronizations, status.steps);
+        output += emio::format("Last offset: {} us\r\n", status.last_offset_us);
+        output += emio::format("Drift: {} ppb\r\n", status.drift_ppb);
+    }
+    auto now = Time_sync::Now();
+    if (now.has_value()) {
+        output += emio::format("Synchronized time: {} us\r\n", now.value());
+    }
+    cli->Print(output);
+}
@@ -82,6 +82,26 @@ public:
      */
     void Thread_statistics();
 
+    /**
+     * @brief   Print statistics of CAN message dispatching (wakeups, receive to dispatch latency, handler execution times)
+     */
+    void Dispatch_statistics();
+
+    /**
+     * @brief   Print statistics of CAN bus (frames, drops, errors, queue high-water marks, utilization)
+     */
+    void CAN_statistics();
+
+    /**
+     * @brief   Print histograms of latencies recorded by latency probes
+     */
+    void Latency_histograms();
+
+    /**
+     * @brief   Print state of time synchronization (offset, drift, synchronized time)
+     */
+    void Time_synchronization();
+
     /**
      * @brief   Put MCU into bootloader mode in order to update firmware
      */
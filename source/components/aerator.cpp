@@ -11,6 +11,8 @@ Aerator::Aerator(uint gpio_in1, uint gpio_in2, EEPROM_storage * const memory, fl
     };
     pump_stopper = new rtos::Delayed_execution(stopper_lamda);
     Load_max_flowrate();
+
+    Value_registry::Register(Value_registry::Value_id::Aerator_flowrate, Component_type(), [this](){ return std::optional<float>(Flowrate()); });
 }
 
 void Aerator::Load_max_flowrate(){
@@ -29,12 +31,12 @@ void Aerator::Load_max_flowrate(){
     Logger::Notice("Aerator max flowrate: {:f}", max_flowrate);
 }
 
-bool Aerator::Receive(CAN::Message message){
+bool Aerator::Receive(CAN::Message const &message){
     UNUSED(message);
     return true;
 }
 
-bool Aerator::Receive(Application_message message){
+bool Aerator::Receive(Application_message const &message){
     switch (message.Message_type()) {
         case Codes::Message_type::Aerator_set_speed: {
             App_messages::Aerator::Set_speed set_speed;
@@ -6,6 +6,9 @@ Bottle_temperature::Bottle_temperature(Thermopile * top_sensor, Thermopile * bot
     top_sensor(top_sensor),
     bottom_sensor(bottom_sensor)
 {
+    Value_registry::Register(Value_registry::Value_id::Bottle_temperature, Component_type(), [this](){ return std::optional<float>(Temperature()); });
+    Value_registry::Register(Value_registry::Value_id::Bottle_top_temperature, Component_type(), [this](){ return std::optional<float>(Top_temperature()); });
+    Value_registry::Register(Value_registry::Value_id::Bottle_bottom_temperature, Component_type(), [this](){ return std::optional<float>(Bottom_temperature()); });
 }
 
 float Bottle_temperature::Temperature(){
@@ -28,54 +31,61 @@ float Bottle_temperature::Top_sensor_temperature(){
     return top_sensor->Ambient();
 }
 
-bool Bottle_temperature::Receive(CAN::Message message){
+bool Bottle_temperature::Receive(CAN::Message const &message){
     UNUSED(message);
     return true;
 }
 
-bool Bottle_temperature::Receive(Application_message message){
-    // Initialize temperature filters during first request
+bool Bottle_temperature::Receive(Application_message const &message){
+    // Initialize temperature filters during first request, jobs of component are executed in order so before the request
+    // When job queue is full, initialization is attempted again with next request
     if(not temperature_initialized){
-        Logger::Debug("Bottle temperature initialization");
-        top_sensor->Init_filters();
-        bottom_sensor->Init_filters();
-        temperature_initialized = true;
+        temperature_initialized = Defer([this](){
+            Logger::Debug("Bottle temperature initialization");
+            top_sensor->Init_filters();
+            bottom_sensor->Init_filters();
+        });
     }
 
     switch (message.Message_type()) {
         case Codes::Message_type::Bottle_temperature_request: {
-            App_messages::Bottle_temperature::Temperature_response response(Temperature());
-            Logger::Debug("Bottle temperature: {:05.2f}°C", response.temperature);
-            Send_CAN_message(response);
-            return true;
+            return Defer([this](){
+                App_messages::Bottle_temperature::Temperature_response response(Temperature());
+                Logger::Debug("Bottle temperature: {:05.2f}°C", response.temperature);
+                Send_CAN_message(response);
+            });
         }
 
         case Codes::Message_type::Bottle_top_measured_temperature_request: {
-            App_messages::Bottle_temperature::Top_measured_temperature_response response(Top_temperature());
-            Logger::Debug("Top measured temperature: {:05.2f}°C", response.temperature);
-            Send_CAN_message(response);
-            return true;
+            return Defer([this](){
+                App_messages::Bottle_temperature::Top_measured_temperature_response response(Top_temperature());
+                Logger::Debug("Top measured temperature: {:05.2f}°C", response.temperature);
+                Send_CAN_message(response);
+            });
         }
 
         case Codes::Message_type::Bottle_bottom_measured_temperature_request: {
-            App_messages::Bottle_temperature::Bottom_measured_temperature_response response(Bottom_temperature());
-            Logger::Debug("Bottom measured temperature: {:05.2f}°C", response.temperature);
-            Send_CAN_message(response);
-            return true;
+            return Defer([this](){
+                App_messages::Bottle_temperature::Bottom_measured_temperature_response response(Bottom_temperature());
+                Logger::Debug("Bottom measured temperature: {:05.2f}°C", response.temperature);
+                Send_CAN_message(response);
+            });
         }
 
         case Codes::Message_type::Bottle_top_sensor_temperature_request: {
-            App_messages::Bottle_temperature::Top_sensor_temperature_response response(Top_sensor_temperature());
-            Logger::Debug("Top sensor temperature: {:05.2f}°C", response.temperature);
-            Send_CAN_message(response);
-            return true;
+            return Defer([this](){
+                App_messages::Bottle_temperature::Top_sensor_temperature_response response(Top_sensor_temperature());
+                Logger::Debug("Top sensor temperature: {:05.2f}°C", response.temperature);
+                Send_CAN_message(response);
+            });
         }
 
         case Codes::Message_type::Bottle_bottom_sensor_temperature_request: {
-            App_messages::Bottle_temperature::Bottom_sensor_temperature_response response(Bottom_sensor_temperature());
-            Logger::Debug("Bottom sensor temperature: {:05.2f}°C", response.temperature);
-            Send_CAN_message(response);
-            return true;
+            return Defer([this](){
+                App_messages::Bottle_temperature::Bottom_sensor_temperature_response response(Bottom_sensor_temperature());
+                Logger::Debug("Bottom sensor temperature: {:05.2f}°C", response.temperature);
+                Send_CAN_message(response);
+            });
         }
 
         default:
@@ -9,6 +9,10 @@ Common_core::Common_core(fra::MutexStandard * const adc_mutex):
     adc_mutex(adc_mutex)
 {
     green_led->Set(false);
+    Segmented_transfer::Init();
+    Job_executor::Init();
+    Request_tracker::Init();
+    Time_sync::Init();
     mcu_internal_temp = new RP_internal_temperature(3.30f);
 
     auto usage_sampler = [this](){
@@ -16,20 +20,36 @@ Common_core::Common_core(fra::MutexStandard * const adc_mutex):
     };
 
     idle_thread_sampler = new rtos::Repeated_execution(usage_sampler, 2000, true);
+
+    Value_registry::Register(Value_registry::Value_id::Core_temperature, Component_type(), [this](){ return MCU_core_temperature(); });
+    Value_registry::Register(Value_registry::Value_id::Core_load, Component_type(), [this](){ return Get_core_load(); });
+    Value_registry::Register(Value_registry::Value_id::Board_temperature, Component_type(), [](){ return Base_module::Singleton_instance()->Board_temperature(); });
 }
 
-bool Common_core::Receive(CAN::Message message){
+bool Common_core::Receive(CAN::Message const &message){
     UNUSED(message);
     return true;
 }
 
-bool Common_core::Receive(Application_message message){
+bool Common_core::Receive(Application_message const &message){
     std::string command_name = "";
 
     switch (message.Message_type()){
+        case Codes::Message_type::Multi_get_request:
+            // Getters read sensors over I2C or ADC, each value is read in work queue of its owning component
+            return Value_registry::Receive(message);
+
         case Codes::Message_type::Ping_request:
             return Ping(message);
 
+        case Codes::Message_type::Latency_probe_request:
+        case Codes::Message_type::Latency_histogram_request:
+            return Latency_probe::Receive(message);
+
+        case Codes::Message_type::Time_sync:
+        case Codes::Message_type::Time_sync_follow_up:
+            return Time_sync::Receive(message);
+
         case Codes::Message_type::Core_temperature_request:
             return Core_temperature();
 
@@ -66,12 +86,26 @@ bool Common_core::Receive(Application_message message){
         case Codes::Message_type::Core_hw_version_request:
             return HW_version();
 
+        case Codes::Message_type::Core_can_statistics_request:
+            return CAN_statistics();
+
+        case Codes::Message_type::Core_dispatch_statistics_request:
+            return Dispatch_profiler::Receive(message);
+
+        case Codes::Message_type::Telemetry_subscribe_request:
+            return Telemetry_service::Receive(message);
+
+        case Codes::Message_type::Segmented_transfer_first:
+        case Codes::Message_type::Segmented_transfer_consecutive:
+        case Codes::Message_type::Segmented_transfer_flow_control:
+            return Segmented_transfer::Receive(message);
+
         default:
             return false;
     }
 }
 
-bool Common_core::Ping(Application_message message){
+bool Common_core::Ping(Application_message const &message){
     App_messages::Common::Ping_request ping_request;
     if (!ping_request.Interpret_data(message.data)){
         Logger::Error("Ping_request interpretation failed");
@@ -107,23 +141,21 @@ bool Common_core::Board_temperature(){
 
     auto temp = base_module->Board_temperature();
     if (not temp.has_value()) {
+        // ADC is occupied (for example by measurement), reading is retried by job executor instead of dispatcher
         Logger::Warning("Board temperature not available");
-        auto lambda = [this, base_module]()-> bool {
-            auto temp = base_module->Board_temperature();
-            if (temp.has_value()){
-                Logger::Notice("Board until temperature available");
-                Logger::Debug("Board temperature: {:05.2f}˚C", temp.value());
-                auto temp_response = App_messages::Common::Board_temp_response(temp.value());
-                Send_CAN_message(temp_response);
-                return true;
-            } else {
-                Logger::Warning("Board until temperature not available");
-                return false;
+        return Defer([this, base_module](){
+            for (uint attempt = 0; attempt < board_temperature_retries; attempt++) {
+                rtos::Delay(500);
+                auto temp = base_module->Board_temperature();
+                if (temp.has_value()) {
+                    Logger::Debug("Board temperature: {:05.2f}˚C", temp.value());
+                    auto temp_response = App_messages::Common::Board_temp_response(temp.value());
+                    Send_CAN_message(temp_response);
+                    return;
+                }
             }
-        };
-        new rtos::Execute_until(lambda, 500, true, true);
-        return false;
-
+            Logger::Warning("Board temperature not available, request dropped");
+        });
     }
     Logger::Debug("Board temperature: {:05.2f}˚C", temp.value());
     auto temp_response = App_messages::Common::Board_temp_response(temp.value());
@@ -247,6 +279,52 @@ bool Common_core::HW_version(){
     return true;
 }
 
+bool Common_core::CAN_statistics(){
+    CAN_thread * can_thread = Base_module::CAN_manager();
+    if (can_thread == nullptr) {
+        Logger::Error("CAN statistics not available");
+        return false;
+    }
+
+    auto bus = can_thread->Bus_statistics();
+    auto const &tx = can_thread->TX_stats();
+
+    const std::pair<CAN::Statistics_counter, uint32_t> counters[] = {
+        {CAN::Statistics_counter::RX_frames,                bus.rx_frames},
+        {CAN::Statistics_counter::RX_bytes,                 bus.rx_bytes},
+        {CAN::Statistics_counter::TX_frames,                bus.tx_frames},
+        {CAN::Statistics_counter::TX_bytes,                 bus.tx_bytes},
+        {CAN::Statistics_counter::RX_dropped,               bus.rx_dropped},
+        {CAN::Statistics_counter::RX_filtered,              bus.rx_filtered},
+        {CAN::Statistics_counter::Errors,                   bus.errors},
+        {CAN::Statistics_counter::RX_high_water,            bus.rx_high_water},
+        {CAN::Statistics_counter::TX_immediate,             tx.immediate},
+        {CAN::Statistics_counter::TX_retransmits,           tx.retransmits},
+        {CAN::Statistics_counter::TX_dropped_emergency,     tx.dropped[0]},
+        {CAN::Statistics_counter::TX_dropped_normal,        tx.dropped[1]},
+        {CAN::Statistics_counter::TX_dropped_bulk,          tx.dropped[2]},
+        {CAN::Statistics_counter::TX_high_water_emergency,  tx.high_water[0]},
+        {CAN::Statistics_counter::TX_high_water_normal,     tx.high_water[1]},
+        {CAN::Statistics_counter::TX_high_water_bulk,       tx.high_water[2]},
+        {CAN::Statistics_counter::Utilization_permille,     static_cast<uint32_t>(can_thread->Bus_utilization() * 1000.0f)},
+        {CAN::Statistics_counter::TX_throttled_normal,      tx.throttled[1]},
+        {CAN::Statistics_counter::TX_throttled_bulk,        tx.throttled[2]},
+    };
+
+    for (auto const &[counter, value] : counters) {
+        etl::vector<uint8_t, 8> data = {
+            static_cast<uint8_t>(counter),
+            static_cast<uint8_t>(value >> 24),
+            static_cast<uint8_t>(value >> 16),
+            static_cast<uint8_t>(value >> 8),
+            static_cast<uint8_t>(value),
+        };
+        Application_message response(Codes::Message_type::Core_can_statistics_response, data);
+        Send_CAN_message(response, CAN::TX_priority::Bulk);
+    }
+    return true;
+}
+
 void Common_core::Sample_core_load(){
     static uint32_t last_runtime_sample = 0;
     static uint32_t last_idle_thread_sample = 0;
@@ -9,6 +9,12 @@
 
 #include "can_bus/app_message.hpp"
 #include "can_bus/message_receiver.hpp"
+#include "can_bus/segmented_transfer.hpp"
+#include "can_bus/telemetry_service.hpp"
+#include "can_bus/request_tracker.hpp"
+#include "can_bus/latency_probe.hpp"
+#include "can_bus/dispatch_profiler.hpp"
+#include "can_bus/time_sync.hpp"
 #include "hal/gpio/gpio.hpp"
 #include "rtos/delayed_execution.hpp"
 #include "rtos/repeated_execution.hpp"
@@ -215,7 +221,7 @@ public:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(CAN::Message message) override final;
+    virtual bool Receive(CAN::Message const &message) override final;
 
     /**
      * @brief   Receive message implementation from Message_receiver interface for Application messages (extended frame)
@@ -225,7 +231,7 @@ public:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(Application_message message) override final;
+    virtual bool Receive(Application_message const &message) override final;
 
     /**
      * @brief   Process received ping request, send response with same sequence number
@@ -234,7 +240,7 @@ public:
      * @return true     Ping response was sent
      * @return false    Ping response cannot be sent (for example due to missing sequence number)
      */
-    bool Ping(Application_message message);
+    bool Ping(Application_message const &message);
 
     /**
      * @brief   Process received request for MCU core temperature, send response with current MCU core temperature
@@ -244,10 +250,16 @@ public:
      */
     bool Core_temperature();
 
+    /**
+     * @brief   Number of attempts to read board temperature when ADC is occupied, attempts are 500 ms apart
+     */
+    static constexpr uint board_temperature_retries = 20;
+
     /**
      * @brief   Respond to request for board temperature retrieved from module
+     *          When ADC is occupied reading is retried by job executor
      *
-     * @return true     Response with board temperature was sent
+     * @return true     Response with board temperature was sent or reading was deferred
      * @return false    Board temperature cannot be obtained
      */
     bool Board_temperature();
@@ -306,6 +318,15 @@ public:
      */
     bool HW_version();
 
+    /**
+     * @brief   Respond to request for CAN bus statistics, response is burst of frames one per counter
+     *          (see CAN::Statistics_counter)
+     *
+     * @return true     All counters were sent
+     * @return false    CAN thread is not available or response cannot be sent
+     */
+    bool CAN_statistics();
+
     /**
      * @brief   Get current MCU core temperature
      *
@@ -10,12 +10,24 @@ Codes::Component Component::Component_type() const{
     return component;
 }
 
-uint Component::Send_CAN_message(App_messages::Base_message &message) {
-    return Base_module::Send_CAN_message(message);
+uint Component::Send_CAN_message(App_messages::Base_message &message, CAN::TX_priority priority) {
+    return Base_module::Send_CAN_message(message, priority);
 }
 
-uint Component::Send_CAN_message(CAN::Message &message) {
-    return Base_module::Send_CAN_message(message);
+uint Component::Send_CAN_message(CAN::Message &message, CAN::TX_priority priority) {
+    return Base_module::Send_CAN_message(message, priority);
+}
+
+bool Component::Send_CAN_message_blocking(App_messages::Base_message &message, CAN::TX_priority priority, uint32_t timeout_ms) {
+    return Base_module::Send_CAN_message_blocking(message, priority, timeout_ms);
+}
+
+bool Component::Send_CAN_message_blocking(CAN::Message const &message, CAN::TX_priority priority, uint32_t timeout_ms) {
+    return Base_module::Send_CAN_message_blocking(message, priority, timeout_ms);
+}
+
+bool Component::Defer(Job_executor::Job job) {
+    return Job_executor::Submit(component, std::move(job), Dispatch_profiler::Defer_origin());
 }
 
 etl::vector<Codes::Component, 256> Component::Available_components() {
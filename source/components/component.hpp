@@ -11,6 +11,8 @@
 
 #include "codes/messages/base_message.hpp"
 #include "can_bus/can_message.hpp"
+#include "can_bus/value_registry.hpp"
+#include "threads/job_executor.hpp"
 
 #include "etl/vector.h"
 
@@ -51,11 +53,26 @@ public:
      *          This is wrapper around Base_m,odule wrapper for can_thread
      *
      * @param message   Message to send
+     * @param priority  Priority class of message, emergency messages are transmitted before all others
      * @return uint     Number of messages waiting in a buffer to be send
      */
-    uint Send_CAN_message(App_messages::Base_message &message);
+    uint Send_CAN_message(App_messages::Base_message &message, CAN::TX_priority priority = CAN::TX_priority::Normal);
 
-    uint Send_CAN_message(CAN::Message &message);
+    uint Send_CAN_message(CAN::Message &message, CAN::TX_priority priority = CAN::TX_priority::Normal);
+
+    bool Send_CAN_message_blocking(App_messages::Base_message &message, CAN::TX_priority priority, uint32_t timeout_ms);
+
+    bool Send_CAN_message_blocking(CAN::Message const &message, CAN::TX_priority priority, uint32_t timeout_ms);
+
+    /**
+     * @brief   Defer work to job executor, handlers of messages which wait for hardware use this to not block dispatcher
+     *          Jobs of one component are executed in order of submission and never concurrently
+     *
+     * @param job       Work to execute, usually sends response itself
+     * @return true     Job was enqueued
+     * @return false    Work queue of component is full
+     */
+    bool Defer(Job_executor::Job job);
 
     /**
      * @brief   Return list of available components
@@ -12,6 +12,8 @@ Cuvette_pump::Cuvette_pump(uint gpio_in1, uint gpio_in2, float cuvette_system_vo
     };
     pump_stopper = new rtos::Delayed_execution(stopper_lamda);
     Load_max_flowrate();
+
+    Value_registry::Register(Value_registry::Value_id::Cuvette_pump_flowrate, Component_type(), [this](){ return std::optional<float>(Flowrate()); });
 }
 
 void Cuvette_pump::Load_max_flowrate(){
@@ -30,12 +32,12 @@ void Cuvette_pump::Load_max_flowrate(){
     Logger::Notice("Cuvette_pump max flowrate: {:f}", max_flowrate);
 }
 
-bool Cuvette_pump::Receive(CAN::Message message){
+bool Cuvette_pump::Receive(CAN::Message const &message){
     UNUSED(message);
     return true;
 }
 
-bool Cuvette_pump::Receive(Application_message message){
+bool Cuvette_pump::Receive(Application_message const &message){
     switch (message.Message_type()) {
         case Codes::Message_type::Cuvette_pump_set_speed: {
             App_messages::Cuvette_pump::Set_speed set_speed;
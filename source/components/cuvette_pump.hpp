@@ -167,7 +167,7 @@ public:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(CAN::Message message) override final;
+    virtual bool Receive(CAN::Message const &message) override final;
 
         /**
      * @brief   Receive message implementation from Message_receiver interface for Application messages (extended frame)
@@ -177,7 +177,7 @@ public:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(Application_message message) override final;
+    virtual bool Receive(Application_message const &message) override final;
 
 private:
     /**
@@ -18,6 +18,8 @@ Enumerator::Enumerator(Codes::Module module_type, EEPROM_storage * memory, Codes
     module_type(module_type),
     memory(memory)
 {
+    Set_instance(instance_type);
+
     if (instance_type == Codes::Instance::Exclusive) {
         Logger::Notice("Enumerator initialized as Exclusive instance");
         current_state = State::exclusive;
@@ -53,6 +55,11 @@ Codes::Instance Enumerator::Instance() const{
     return current_instance;
 }
 
+void Enumerator::Set_instance(Codes::Instance instance){
+    current_instance = instance;
+    CAN::Acceptance_filter::Instance(current_instance);
+}
+
 Codes::Instance Enumerator::Wanted_instance() const{
     return wanted_instance;
 }
@@ -202,7 +209,7 @@ void Enumerator::Finish_enumerate(){
     Logger::Notice("Enumerator has successfully registered as Instance {}", magic_enum::enum_name(wanted_instance));
     
     led_duty_cycle = 4;
-    current_instance = wanted_instance;
+    Set_instance(wanted_instance);
 
     Show_instance_color();
 
@@ -222,7 +229,7 @@ void Enumerator::Resolve_collision(){
     Logger::Warning("Enumerator has collided with another module while trying to register as Instance {}", magic_enum::enum_name(wanted_instance));
     
     led_duty_cycle = 1;
-    current_instance = Codes::Instance::Undefined;
+    Set_instance(Codes::Instance::Undefined);
 
 }
 
@@ -244,12 +251,12 @@ void Enumerator::Enumeration_button_pressed(){
     
 }
 
-bool Enumerator::Receive(CAN::Message message){
+bool Enumerator::Receive(CAN::Message const &message){
     UNUSED(message);
     return true;
 }
 
-bool Enumerator::Receive(Application_message message){
+bool Enumerator::Receive(Application_message const &message){
     switch (message.Message_type()){
         case Codes::Message_type::Enumerator_collision: {
             if (message.Module_type() != module_type){
@@ -11,6 +11,7 @@
 
 #include "can_bus/message_router.hpp"
 #include "can_bus/message_receiver.hpp"
+#include "can_bus/acceptance_filter.hpp"
 #include "components/component.hpp"
 #include "components/led/addressable_LED.hpp"
 #include "hal/gpio/gpio_irq.hpp"
@@ -194,6 +195,13 @@ public:
     bool Valid() const;
 
 private:
+    /**
+     * @brief   Set current instance of module and update acceptance filter of CAN bus to new instance
+     *
+     * @param instance  New instance of module
+     */
+    void Set_instance(Codes::Instance instance);
+
     /**
      * @brief   Load last used instance from persistent EEPROM memory
      *
@@ -284,7 +292,7 @@ protected:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(CAN::Message message) override final;
+    virtual bool Receive(CAN::Message const &message) override final;
 
     /**
      * @brief   Receive message implementation from Message_receiver interface for Application messages (extended frame)
@@ -294,6 +302,6 @@ protected:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(Application_message message) override final;
+    virtual bool Receive(Application_message const &message) override final;
 
 };
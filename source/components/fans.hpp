@@ -19,9 +19,9 @@ private:
 public:
     Fan(etl::vector<float, 8> &channels);
 
-    bool Receive(CAN::Message message) override final;
+    bool Receive(CAN::Message const &message) override final;
 
-    bool Receive(Application_message message) override final;
+    bool Receive(Application_message const &message) override final;
 
     bool Set_intensity(uint8_t channel, float intensity);
 
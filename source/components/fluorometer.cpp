@@ -44,19 +44,26 @@ void Fluorometer::Calibrate(){
     calibration_data.timing_us.fill(0);
     calibration_data.calibrated = false;
 
-    // Initialize calibration data
-    bool stat = Capture_OJIP(
+    // Calibration reference is single capture with single conversions, independent of options of measurements
+    Capture_options measurement_options = capture_options;
+    capture_options = {};
+
+    bool stat = Capture_OJIP_single(
         calibration_data.gain,
         calibration_data.intensity,
         calibration_data.length,
         calibration_data.sample_count,
         calibration_data.timing);
 
+    capture_options = measurement_options;
+
     if (!stat) {
         Logger::Error("Capture OJIP failed");
         return;
     }
 
+    ojip_capture_finished = true;
+
     // Copy captured value and timings to calibration data
     for(size_t i = 0; i < calibration_data.adc_value.size(); i++){
         calibration_data.adc_value[i] = OJIP_data.intensity[i];
@@ -151,6 +158,50 @@ Fluorometer_config::Gain Fluorometer::Gain(){
 
 
 bool Fluorometer::Capture_OJIP(Fluorometer_config::Gain gain, float emitor_intensity, float capture_length, uint samples, Fluorometer_config::Timing timing) {
+    uint8_t repetitions = std::max<uint8_t>(capture_options.repetitions, 1);
+    bool status = true;
+
+    for (uint8_t repetition = 0; repetition < repetitions; repetition++) {
+        if (repetition > 0) {
+            Logger::Notice("Dark adaptation {} s before capture {}/{}", capture_options.dark_adaptation_s, repetition + 1, repetitions);
+            rtos::Delay(capture_options.dark_adaptation_s * 1000);
+        }
+
+        status = Capture_OJIP_single(gain, emitor_intensity, capture_length, samples, timing);
+        if (not status) {
+            Logger::Error("OJIP capture {}/{} failed", repetition + 1, repetitions);
+            break;
+        }
+
+        if (repetitions == 1) {
+            break;
+        }
+
+        if (repetition == 0) {
+            intensity_accumulator.assign(OJIP_data.intensity.begin(), OJIP_data.intensity.end());
+        } else {
+            for (size_t i = 0; i < intensity_accumulator.size(); i++) {
+                intensity_accumulator[i] += OJIP_data.intensity[i];
+            }
+        }
+    }
+
+    if (status and (repetitions > 1)) {
+        for (size_t i = 0; i < intensity_accumulator.size(); i++) {
+            OJIP_data.intensity[i] = (intensity_accumulator[i] + repetitions / 2) / repetitions;
+        }
+        Logger::Notice("Averaged {} OJIP captures", repetitions);
+    }
+
+    // Failed repetition leaves partial curve, capture is not reported as finished
+    if (status) {
+        ojip_capture_finished = true;
+    }
+
+    return status;
+}
+
+bool Fluorometer::Capture_OJIP_single(Fluorometer_config::Gain gain, float emitor_intensity, float capture_length, uint samples, Fluorometer_config::Timing timing) {
     Logger::Warning("Capture OJIP initiated");
 
     OJIP_data.sample_count = samples;
@@ -159,36 +210,22 @@ bool Fluorometer::Capture_OJIP(Fluorometer_config::Gain gain, float emitor_inten
         return false;
     }
 
-    uint32_t sys_clock_hz = clock_get_hz(clk_sys);
-    uint32_t ticks_per_us = sys_clock_hz / 1'000'000 / timer_clock_divider;
-    uint32_t max_sample_span_us = (1 << 16) / ticks_per_us;
-
-    // Determine number of samples in fast phase
-    int fast_phase_samples = 0;
-    for (size_t i = 0; i < capture_timing.size(); i++) {
-        uint32_t span = capture_timing[i];
-        if (span < max_sample_span_us) {
-            fast_phase_samples++;
-        } else {
-            break;
-        }
-    }
+    int timestamp_dma_channel, wrap_dma_channel, divider_dma_channel, adc_dma_channel;
 
-    int timestamp_dma_channel, wrap_dma_channel, adc_dma_channel;
-
-    if (!OJIP_phase_1_Configuration(timestamp_dma_channel, wrap_dma_channel, adc_dma_channel, fast_phase_samples)) {
+    if (!OJIP_phase_1_Configuration(timestamp_dma_channel, wrap_dma_channel, divider_dma_channel, adc_dma_channel)) {
         return false;
     }
 
-    uint64_t start_time = OJIP_phase_2_Fast_phase(timestamp_dma_channel, wrap_dma_channel, adc_dma_channel);
+    uint64_t start_time = OJIP_phase_2_Capture();
 
-    uint64_t stop_time = OJIP_phase_3_Slow_phase(ticks_per_us, fast_phase_samples);
+    uint64_t stop_time = 0;
+    bool capture_complete = OJIP_phase_3_Completion(timestamp_dma_channel, wrap_dma_channel, divider_dma_channel, adc_dma_channel, stop_time);
 
     if (!OJIP_phase_4_Post_processing(start_time, stop_time)) {
         return false;
     }
 
-    return true;
+    return capture_complete;
 }
 
 bool Fluorometer::OJIP_phase_0_Preparation(Fluorometer_config::Gain gain, float emitor_intensity, float capture_length, Fluorometer_config::Timing timing) {
@@ -197,8 +234,13 @@ bool Fluorometer::OJIP_phase_0_Preparation(Fluorometer_config::Gain gain, float
     OJIP_data.sample_time_us.fill(0);
     OJIP_data.intensity.resize(OJIP_data.sample_count);
     OJIP_data.intensity.fill(0);
+    OJIP_data.conversions.resize(OJIP_data.sample_count);
+    OJIP_data.conversions.fill(1);
+    OJIP_parameters_data = {};
     OJIP_data.emitor_intensity = emitor_intensity;
     OJIP_data.detector_gain = gain;
+    OJIP_data.sample_range = capture_length;
+    OJIP_data.timing = timing;
     capture_timing.resize(OJIP_data.sample_count);
     capture_timing.fill(0);
 
@@ -212,16 +254,110 @@ bool Fluorometer::OJIP_phase_0_Preparation(Fluorometer_config::Gain gain, float
     }
 
     uint32_t sys_clock_hz = clock_get_hz(clk_sys);
-    uint32_t ticks_per_us = sys_clock_hz / 1'000'000 / timer_clock_divider;
-    // multiply all timing by ticks_per_us for resolution
-    for (size_t i = 0; i < capture_timing.size(); i++) {
-        capture_timing[i] = capture_timing[i] * ticks_per_us;
+    if (not Prescale_timing(sys_clock_hz)) {
+        return false;
+    }
+
+    // Sample is captured at every wrap, intermediate wraps of long intervals are merged in post-processing
+    OJIP_data.sample_time_us.resize(capture_timing.size(), 0);
+    OJIP_data.intensity.resize(capture_timing.size(), 0);
+    OJIP_data.conversions.resize(capture_timing.size(), 1);
+    return true;
+}
+
+bool Fluorometer::Prescale_timing(uint32_t sys_clock_hz) {
+    const uint64_t counter_range = static_cast<uint64_t>(UINT16_MAX) + 1;
+    const uint64_t max_wrap_cycles = counter_range * max_timer_clock_divider;
+    const size_t samples = capture_timing.size();
+
+    // Long intervals are split into equal wraps, each of them fits into counter with maximal divider
+    sample_wraps.resize(samples);
+    size_t wraps = 0;
+    for (size_t i = 0; i < samples; i++) {
+        uint64_t cycles = static_cast<uint64_t>(capture_timing[i]) * sys_clock_hz / 1'000'000;
+        sample_wraps[i] = std::max<uint64_t>(1, (cycles + max_wrap_cycles - 1) / max_wrap_cycles);
+        wraps += sample_wraps[i];
+    }
+
+    if (wraps > capture_timing.capacity()) {
+        Logger::Error("Capture requires {} wraps of sampler trigger, maximum is {}, use less samples or shorter capture", wraps, capture_timing.capacity());
+        return false;
+    }
+
+    // Tables are expanded from end, so intervals of samples before currently expanded one are not overwritten
+    capture_timing.resize(wraps);
+    capture_divider.resize(wraps);
+    uint64_t duration_us = 0;
+    uint32_t highest_divider = timer_clock_divider;
+    size_t wrap = wraps;
+
+    for (size_t i = samples; i-- > 0;) {
+        uint32_t interval_us = capture_timing[i];
+        duration_us += interval_us;
+
+        uint64_t cycles = static_cast<uint64_t>(interval_us) * sys_clock_hz / 1'000'000;
+        uint16_t split = sample_wraps[i];
+        uint32_t divider = std::max<uint64_t>(timer_clock_divider, (cycles + split * counter_range - 1) / (split * counter_range));
+
+        // Remainder of counts is distributed over first wraps, so whole interval is paced with resolution of single count
+        uint64_t counts = (cycles + divider / 2) / divider;
+        for (uint16_t part = split; part-- > 0;) {
+            wrap--;
+            uint64_t part_counts = counts / split + ((part < (counts % split)) ? 1 : 0);
+            capture_timing[wrap] = std::min<uint64_t>(part_counts, UINT16_MAX);
+            capture_divider[wrap] = divider;
+        }
+
+        highest_divider = std::max(highest_divider, divider);
+    }
+
+    // Wrap value is double-buffered and takes effect after next wrap, divider takes effect immediately
+    // so divider of each wrap is written one wrap later than its wrap value
+    for (size_t i = wraps; i-- > 0;) {
+        uint32_t applied_divider = (i == 0) ? capture_divider[i] : capture_divider[i - 1];
+        capture_divider[i] = applied_divider << PWM_CH0_DIV_INT_LSB;
+    }
+
+    capture_duration_us = duration_us;
+    Logger::Notice("Capture duration: {} us, wraps: {}, maximal divider: {}", capture_duration_us, wraps, highest_divider);
+    return true;
+}
+
+bool Fluorometer::Merge_wraps() {
+    const size_t samples = sample_wraps.size();
+    if (OJIP_data.intensity.size() == samples) {
+        return false;
+    }
+
+    // Groups are compacted forward, sample is always written at or before first wrap of its group
+    size_t wrap = 0;
+    for (size_t i = 0; i < samples; i++) {
+        uint64_t sum = 0;
+        uint32_t count = 0;
+        for (uint16_t part = 0; part < sample_wraps[i]; part++, wrap++) {
+            sum += static_cast<uint64_t>(OJIP_data.intensity[wrap]) * OJIP_data.conversions[wrap];
+            count += OJIP_data.conversions[wrap];
+        }
+
+        size_t last = wrap - 1;
+        OJIP_data.sample_time_us[i] = OJIP_data.sample_time_us[last];
+        if (capture_options.bin_averaging and (count > 0)) {
+            // Bin of sample spans all wraps of its interval
+            OJIP_data.intensity[i] = sum / count;
+            OJIP_data.conversions[i] = std::min<uint32_t>(count, UINT16_MAX);
+        } else {
+            OJIP_data.intensity[i] = OJIP_data.intensity[last];
+            OJIP_data.conversions[i] = OJIP_data.conversions[last];
+        }
     }
 
+    OJIP_data.sample_time_us.resize(samples);
+    OJIP_data.intensity.resize(samples);
+    OJIP_data.conversions.resize(samples);
     return true;
 }
 
-bool Fluorometer::OJIP_phase_1_Configuration(int& timestamp_dma_channel, int& wrap_dma_channel, int& adc_dma_channel, int fast_phase_samples) {
+bool Fluorometer::OJIP_phase_1_Configuration(int& timestamp_dma_channel, int& wrap_dma_channel, int& divider_dma_channel, int& adc_dma_channel) {
     Logger::Notice("Configuring ADC");
     adc_init();
     adc_gpio_init(26 + 1);
@@ -265,23 +401,30 @@ bool Fluorometer::OJIP_phase_1_Configuration(int& timestamp_dma_channel, int& wr
 
     pwm_config pwm_cfg = pwm_get_default_config();
     pwm_set_counter(sampler_trigger_slice, 0);
-    pwm_config_set_clkdiv_int(&pwm_cfg, timer_clock_divider);
+    pwm_config_set_clkdiv_int(&pwm_cfg, capture_divider[0] >> PWM_CH0_DIV_INT_LSB);
     pwm_init(sampler_trigger_slice, &pwm_cfg, false);
     pwm_set_wrap(sampler_trigger_slice, capture_timing[0]);
 
     Logger::Notice("Configuring DMA channels");
 
-    timestamp_dma_channel = dma_claim_unused_channel(true);
-    wrap_dma_channel      = dma_claim_unused_channel(true);
-    adc_dma_channel       = dma_claim_unused_channel(true);
+    timestamp_dma_channel = dma_claim_unused_channel(false);
+    wrap_dma_channel      = dma_claim_unused_channel(false);
+    divider_dma_channel   = dma_claim_unused_channel(false);
+    adc_dma_channel       = dma_claim_unused_channel(false);
 
-    if (timestamp_dma_channel == -1 || wrap_dma_channel == -1 || adc_dma_channel == -1) {
+    if (timestamp_dma_channel == -1 || wrap_dma_channel == -1 || divider_dma_channel == -1 || adc_dma_channel == -1) {
         Logger::Error("DMA channels not available");
+        for (int channel : {timestamp_dma_channel, wrap_dma_channel, divider_dma_channel, adc_dma_channel}) {
+            if (channel != -1) {
+                dma_channel_unclaim(channel);
+            }
+        }
         return false;
     }
 
     dma_channel_config timestamp_dma_config = dma_channel_get_default_config(timestamp_dma_channel);
     dma_channel_config wrap_dma_config      = dma_channel_get_default_config(wrap_dma_channel);
+    dma_channel_config divider_dma_config   = dma_channel_get_default_config(divider_dma_channel);
     dma_channel_config adc_dma_config       = dma_channel_get_default_config(adc_dma_channel);
 
     uint pwm_channel_dreq = pwm_get_dreq(sampler_trigger_slice);
@@ -298,6 +441,12 @@ bool Fluorometer::OJIP_phase_1_Configuration(int& timestamp_dma_channel, int& wr
     channel_config_set_write_increment(&wrap_dma_config, false);               // Fixed dest register
     channel_config_set_dreq(&wrap_dma_config, pwm_channel_dreq);               // Trigger DMA by PWM wrap of trigger timer
 
+    // Switch of divider for long intervals
+    channel_config_set_transfer_data_size(&divider_dma_config, DMA_SIZE_16);   // 16-bit transfers, replicated to whole register
+    channel_config_set_read_increment(&divider_dma_config, true);              // Increment source in memory
+    channel_config_set_write_increment(&divider_dma_config, false);            // Fixed dest register
+    channel_config_set_dreq(&divider_dma_config, pwm_channel_dreq);            // Trigger DMA by PWM wrap of trigger timer
+
     // ADC samples from detector
     channel_config_set_transfer_data_size(&adc_dma_config, DMA_SIZE_16);       // 16-bit transfers
     channel_config_set_read_increment(&adc_dma_config, false);                 // Fixed source FIFO
@@ -309,7 +458,7 @@ bool Fluorometer::OJIP_phase_1_Configuration(int& timestamp_dma_channel, int& wr
         &timestamp_dma_config,
         OJIP_data.sample_time_us.data(),            // Destination buffer
         &timer_hw->timerawl,                        // Source: Timer counter (lower 32 bits), increments every 1 us
-        fast_phase_samples,                                    // Number of transfers
+        capture_timing.size(),                      // Number of transfers, one per wrap
         true                                        // Start immediately but wait wait for trigger
     );
 
@@ -319,23 +468,58 @@ bool Fluorometer::OJIP_phase_1_Configuration(int& timestamp_dma_channel, int& wr
         &wrap_dma_config,
         &pwm_hw->slice[sampler_trigger_slice].top,  // Destination buffer slice threshold
         capture_timing.data(),                      // Source: Timer counter (lower 32 bits)
-        fast_phase_samples,                                    // Number of transfers
+        capture_timing.size(),                      // Number of transfers, one per wrap
         true                                        // Start immediately but wait wait for trigger
     );
 
     dma_channel_configure(
-        adc_dma_channel,
-        &adc_dma_config,
-        OJIP_data.intensity.data(),                 // Destination buffer
-        &adc_hw->fifo,                              // Source: ADC fifo with length 1
-        fast_phase_samples,                                    // Number of transfers
+        divider_dma_channel,
+        &divider_dma_config,
+        &pwm_hw->slice[sampler_trigger_slice].div,  // Destination: slice clock divider
+        capture_divider.data(),                     // Source: divider of each interval
+        capture_timing.size(),                      // Number of transfers, one per wrap
         true                                        // Start immediately but wait wait for trigger
     );
 
+    if (capture_options.bin_averaging) {
+        if (not Configure_bin_averaging(adc_dma_channel)) {
+            dma_channel_abort(timestamp_dma_channel);
+            dma_channel_abort(wrap_dma_channel);
+            dma_channel_abort(divider_dma_channel);
+            for (int channel : {timestamp_dma_channel, wrap_dma_channel, divider_dma_channel, adc_dma_channel}) {
+                dma_channel_unclaim(channel);
+            }
+            return false;
+        }
+    } else {
+        dma_channel_configure(
+            adc_dma_channel,
+            &adc_dma_config,
+            OJIP_data.intensity.data(),                 // Destination buffer
+            &adc_hw->fifo,                              // Source: ADC fifo with length 1
+            capture_timing.size(),                      // Number of transfers, one per wrap
+            true                                        // Start immediately but wait wait for trigger
+        );
+    }
+
+    // Transfer of last sample wakes up thread waiting for completion
+    if (capture_done == nullptr) {
+        capture_done = new fra::BinarySemaphore();
+    }
+    if (not capture_irq_registered) {
+        irq_add_shared_handler(DMA_IRQ_1, Capture_complete_IRQ, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_1, true);
+        capture_irq_registered = true;
+    }
+    capture_done->Take(0);
+    capture_completion_channel = adc_dma_channel;
+    dma_channel_acknowledge_irq1(adc_dma_channel);
+    dma_channel_set_irq1_enabled(adc_dma_channel, true);
+
     return true;
 }
 
-uint64_t Fluorometer::OJIP_phase_2_Fast_phase(int timestamp_dma_channel, int wrap_dma_channel, int adc_dma_channel) {
+uint64_t Fluorometer::OJIP_phase_2_Capture() {
     // Enable emitor
     Emitor_intensity(OJIP_data.emitor_intensity);
 
@@ -345,84 +529,283 @@ uint64_t Fluorometer::OJIP_phase_2_Fast_phase(int timestamp_dma_channel, int wra
     // Capture time at start of capture
     uint64_t start_time = to_us_since_boot(get_absolute_time());
 
-    // Start trigger timer
+    // Conversions before start of capture are not part of first bin
+    if (capture_options.bin_averaging) {
+        bin_accumulator = {};
+        bin_accumulator.processed = Conversion_ring_position();
+        add_repeating_timer_us(-conversion_ring_drain_us, Conversion_ring_timer_callback, nullptr, &conversion_ring_timer);
+    }
+
+    // Start trigger timer, from now whole capture is paced by PWM wraps and DMA
     pwm_set_enabled(sampler_trigger_slice, true);
 
-    // Wait for DMA stops -> fast phase capture is done
-    while (dma_channel_is_busy(timestamp_dma_channel)) {
-        // Actively wait for DMA to complete
+    return start_time;
+}
+
+bool Fluorometer::OJIP_phase_3_Completion(int timestamp_dma_channel, int wrap_dma_channel, int divider_dma_channel, int adc_dma_channel, uint64_t &stop_time) {
+    // Thread sleeps during capture, other threads (CAN bus, heartbeat) are running
+    uint32_t timeout_ms = capture_duration_us / 1000 + 1000;
+    bool completed = capture_done->Take(cpp_freertos::Ticks::MsToTicks(timeout_ms));
+
+    // Stop PWM trigger
+    pwm_set_enabled(sampler_trigger_slice, false);
+
+    // Last bin is closed after completion of capture, rest of conversions in ring is accumulated here
+    if (conversion_ring_channel != -1) {
+        cancel_repeating_timer(&conversion_ring_timer);
+        Drain_conversion_ring();
+
+        if (bin_accumulator.overruns > 0) {
+            Logger::Warning("Conversion ring overrun {} times, bins are missing conversions", bin_accumulator.overruns);
+        }
+
+        dma_channel_abort(conversion_ring_channel);
+        dma_channel_unclaim(conversion_ring_channel);
+        conversion_ring_channel = -1;
+        bin_boundary_channel = -1;
+    }
+
+    dma_channel_set_irq1_enabled(adc_dma_channel, false);
+    capture_completion_channel = -1;
+
+    if (completed) {
+        stop_time = capture_stop_time;
+        Logger::Notice("Capture complete");
+    } else {
+        stop_time = time_us_64();
+        Logger::Error("Capture not completed in {} ms, captured {} of {} wraps", timeout_ms,
+            capture_timing.size() - dma_channel_hw_addr(adc_dma_channel)->transfer_count, capture_timing.size());
     }
 
     // Deactivate DMA channels
     dma_channel_abort(timestamp_dma_channel);
     dma_channel_abort(wrap_dma_channel);
+    dma_channel_abort(divider_dma_channel);
     dma_channel_abort(adc_dma_channel);
+    dma_channel_acknowledge_irq1(adc_dma_channel);
 
     dma_channel_unclaim(timestamp_dma_channel);
     dma_channel_unclaim(wrap_dma_channel);
+    dma_channel_unclaim(divider_dma_channel);
     dma_channel_unclaim(adc_dma_channel);
 
-    // Stop PWM trigger
-    pwm_set_enabled(sampler_trigger_slice, false);
+    return completed;
+}
+
+void Fluorometer::Capture_complete_IRQ() {
+    int channel = capture_completion_channel;
+    if ((channel == -1) or (not dma_channel_get_irq1_status(channel))) {
+        return;
+    }
+    dma_channel_acknowledge_irq1(channel);
 
-    // Fast phase finished
-    Logger::Notice("Fast phase complete, captured samples");
+    capture_stop_time = time_us_64();
 
-    return start_time;
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    capture_done->GiveFromISR(&higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
 }
 
-uint64_t Fluorometer::OJIP_phase_3_Slow_phase(uint32_t ticks_per_us, int fast_phase_samples) {
+bool Fluorometer::OJIP_phase_5_Parameters() {
+    OJIP_parameters &parameters = OJIP_parameters_data;
+    parameters = {};
 
-    // Structure to pass to the lambda
-    struct Slow_phase_data {
-        uint32_t current_sample_index;
-        uint32_t ticks_per_us;
-        uint64_t stop_time;
-    };
+    const size_t sample_count = OJIP_data.intensity.size();
+    if ((sample_count == 0) or (OJIP_data.sample_time_us.size() != sample_count)) {
+        Logger::Warning("No OJIP data for parameters");
+        return false;
+    }
 
-    Slow_phase_data* data = new Slow_phase_data{static_cast<uint32_t>(fast_phase_samples), ticks_per_us, 0};
-    uint64_t next_sample_time_us = capture_timing[data->current_sample_index] / data->ticks_per_us;
+    // Same correction as export, gain is taken from detector as requested gain can be automatic
+    float gain_value = Fluorometer_config::gain_values.at(calibration_data.gain) / Fluorometer_config::gain_values.at(Gain());
+    Calibration_cursor calibration(calibration_data.timing_us);
 
-    Logger::Notice("Next sample at {} us", next_sample_time_us);
+    bool fo_found = false;
+    bool fj_found = false;
+    bool fi_found = false;
+    size_t fm_index = 0;
 
-    auto Capture_single_sample = [](alarm_id_t id, void *user_data) -> int64_t {
-        UNUSED(id);
+    for (size_t i = 0; i < sample_count; i++) {
+        uint32_t time_us = OJIP_data.sample_time_us[i];
+        uint16_t intensity = Corrected_intensity(&OJIP_data, i, gain_value, calibration);
 
-        Slow_phase_data *data = reinterpret_cast<Slow_phase_data *>(user_data);
-        uint32_t *current_sample_index = &data->current_sample_index;
-        uint32_t ticks_per_us = data->ticks_per_us;
+        // Characteristic points use first sample at or after their time
+        if ((not fo_found) and (time_us >= fo_time_us)) {
+            parameters.fo = intensity;
+            fo_found = true;
+        }
+        if ((not fj_found) and (time_us >= fj_time_us)) {
+            parameters.fj = intensity;
+            fj_found = true;
+        }
+        if ((not fi_found) and (time_us >= fi_time_us)) {
+            parameters.fi = intensity;
+            fi_found = true;
+        }
+        if (intensity > parameters.fm) {
+            parameters.fm = intensity;
+            parameters.fm_time_us = time_us;
+            fm_index = i;
+        }
+    }
 
-        // Capture data
-        OJIP_data.intensity[*current_sample_index] = adc_fifo_get();
-        OJIP_data.sample_time_us[*current_sample_index] = time_us_64();
+    if (parameters.fm == 0) {
+        Logger::Warning("OJIP curve has no maximum, parameters are not valid");
+        return false;
+    }
 
-        (*current_sample_index)++;
+    // Area between curve and Fm up to time of Fm, trapezoidal rule
+    uint64_t area = 0;
+    Calibration_cursor area_calibration(calibration_data.timing_us);
+    uint16_t previous = Corrected_intensity(&OJIP_data, 0, gain_value, area_calibration);
+    for (size_t i = 1; i <= fm_index; i++) {
+        uint16_t current = Corrected_intensity(&OJIP_data, i, gain_value, area_calibration);
+        uint32_t interval_us = OJIP_data.sample_time_us[i] - OJIP_data.sample_time_us[i - 1];
+        area += static_cast<uint64_t>((parameters.fm - previous) + (parameters.fm - current)) * interval_us / 2;
+        previous = current;
+    }
 
-        if (*current_sample_index >= OJIP_data.sample_count) {
-            data->stop_time = time_us_64();
-            return 0;       // No more samples, don't reschedule
-        } else {
-            return capture_timing[*current_sample_index] / ticks_per_us; // Reschedule next capture
-        }
+    parameters.area = area / 1000;
+    parameters.fv_fm = static_cast<float>(parameters.fm - std::min(parameters.fo, parameters.fm)) / parameters.fm;
+    parameters.valid = true;
+
+    Logger::Notice("OJIP parameters: Fo {}, Fj {}, Fi {}, Fm {} at {} us, Fv/Fm {:.3f}, area {}",
+        parameters.fo, parameters.fj, parameters.fi, parameters.fm, parameters.fm_time_us, parameters.fv_fm, parameters.area);
+
+    return true;
+}
+
+bool Fluorometer::Send_OJIP_parameters() {
+    OJIP_parameters const &parameters = OJIP_parameters_data;
+    if (not parameters.valid) {
+        Logger::Warning("OJIP parameters are not available");
+        return false;
+    }
+
+    uint8_t measurement_id = OJIP_data.measurement_id;
+    auto send_field = [this, measurement_id](OJIP_parameter field, uint32_t value){
+        etl::vector<uint8_t, 8> data = {
+            measurement_id,
+            static_cast<uint8_t>(field),
+            static_cast<uint8_t>(value >> 24),
+            static_cast<uint8_t>(value >> 16),
+            static_cast<uint8_t>(value >> 8),
+            static_cast<uint8_t>(value),
+        };
+        Application_message response(Codes::Message_type::Fluorometer_OJIP_parameters, data);
+        Send_CAN_message(response);
     };
 
-    // Start direct read sampling if there are remaining samples for slow phase
-    if (data->current_sample_index < OJIP_data.sample_count) {
-        Logger::Notice("Starting slow phase direct read sampling");
-        add_alarm_in_us(next_sample_time_us, Capture_single_sample, data, true);
+    send_field(OJIP_parameter::Fo, parameters.fo);
+    send_field(OJIP_parameter::Fj, parameters.fj);
+    send_field(OJIP_parameter::Fi, parameters.fi);
+    send_field(OJIP_parameter::Fm, parameters.fm);
+    send_field(OJIP_parameter::Fm_time, parameters.fm_time_us);
+    send_field(OJIP_parameter::Fv_Fm, static_cast<uint32_t>(parameters.fv_fm * 10000.0f + 0.5f));
+    send_field(OJIP_parameter::Area, parameters.area);
+    return true;
+}
+
+bool Fluorometer::Configure_bin_averaging(int adc_dma_channel) {
+    conversion_ring_channel = dma_claim_unused_channel(false);
+    if (conversion_ring_channel == -1) {
+        Logger::Error("DMA channel for conversion ring not available");
+        return false;
     }
 
-    // Wait for all samples to be captured
-    while (data->current_sample_index < OJIP_data.sample_count) {
-        rtos::Yield();
+    // Every conversion of free-running ADC is written into ring
+    dma_channel_config ring_dma_config = dma_channel_get_default_config(conversion_ring_channel);
+    channel_config_set_transfer_data_size(&ring_dma_config, DMA_SIZE_16);      // 16-bit transfers
+    channel_config_set_read_increment(&ring_dma_config, false);                // Fixed source FIFO
+    channel_config_set_write_increment(&ring_dma_config, true);                // Increment destination
+    channel_config_set_ring(&ring_dma_config, true, conversion_ring_bits);     // Wrap destination address within ring
+    channel_config_set_dreq(&ring_dma_config, DREQ_ADC);                       // Paced by ADC conversions
+
+    dma_channel_configure(
+        conversion_ring_channel,
+        &ring_dma_config,
+        conversion_ring.data(),                     // Destination: ring aligned to its size
+        &adc_hw->fifo,                              // Source: ADC fifo
+        UINT32_MAX,                                 // Number of transfers, ring position is derived from remaining transfers
+        true                                        // Start immediately
+    );
+
+    // Position in ring at each wrap of trigger timer marks end of bin
+    dma_channel_config boundary_dma_config = dma_channel_get_default_config(adc_dma_channel);
+    channel_config_set_transfer_data_size(&boundary_dma_config, DMA_SIZE_16);  // Lower 16 bits of remaining transfers
+    channel_config_set_read_increment(&boundary_dma_config, false);            // Fixed source register
+    channel_config_set_write_increment(&boundary_dma_config, true);            // Increment destination
+    channel_config_set_dreq(&boundary_dma_config, pwm_get_dreq(sampler_trigger_slice));
+
+    dma_channel_configure(
+        adc_dma_channel,
+        &boundary_dma_config,
+        OJIP_data.intensity.data(),                 // Destination: intensity buffer, replaced by mean when bin is closed
+        &dma_channel_hw_addr(conversion_ring_channel)->transfer_count,
+        capture_timing.size(),                      // Number of transfers, one per wrap
+        true                                        // Start immediately but wait wait for trigger
+    );
+
+    bin_boundary_channel = adc_dma_channel;
+    return true;
+}
+
+bool Fluorometer::Drain_conversion_ring() {
+    const size_t ring_mask = conversion_ring_samples - 1;
+    const size_t bin_count = capture_timing.size();
+    Bin_accumulator &bins = bin_accumulator;
+
+    // Number of closed bins and ring position are read without wrap in between,
+    //  so all known boundaries are before position and no conversion after unknown boundary is accumulated
+    uint32_t closed_bins;
+    uint32_t position;
+    do {
+        closed_bins = bin_count - dma_channel_hw_addr(bin_boundary_channel)->transfer_count;
+        position = Conversion_ring_position();
+    } while (closed_bins != bin_count - dma_channel_hw_addr(bin_boundary_channel)->transfer_count);
+
+    if ((position - bins.processed) > conversion_ring_samples) {
+        bins.overruns++;
+        bins.processed = position - conversion_ring_samples;
     }
 
-    Logger::Debug("Slow phase sampling complete");
+    while (bins.bin < bin_count) {
+        bool closing = bins.bin < closed_bins;
+        uint32_t end = position;
+        if (closing) {
+            // Boundary is lower 16 bits of remaining transfers, conversion index is its complement
+            uint16_t boundary = ~OJIP_data.intensity[bins.bin];
+            end = position - static_cast<uint16_t>(static_cast<uint16_t>(position) - boundary);
+        }
+
+        for (; static_cast<int32_t>(end - bins.processed) > 0; bins.processed++) {
+            bins.sum += conversion_ring[bins.processed & ring_mask];
+            bins.count++;
+        }
+
+        if (not closing) {
+            break;
+        }
 
-    uint64_t stop_time = data->stop_time;  // Retrieve stop_time
-    delete data;
+        // Bin shorter than conversion uses latest conversion
+        if (bins.count > 0) {
+            OJIP_data.intensity[bins.bin] = bins.sum / bins.count;
+        } else {
+            OJIP_data.intensity[bins.bin] = conversion_ring[(bins.processed - 1) & ring_mask];
+        }
+        OJIP_data.conversions[bins.bin] = std::min<uint32_t>(bins.count, UINT16_MAX);
 
-    return stop_time;
+        bins.sum = 0;
+        bins.count = 0;
+        bins.bin++;
+    }
+
+    return bins.bin < bin_count;
+}
+
+bool Fluorometer::Conversion_ring_timer_callback(repeating_timer_t *timer) {
+    UNUSED(timer);
+    return Drain_conversion_ring();
 }
 
 bool Fluorometer::OJIP_phase_4_Post_processing(uint64_t start_time, uint64_t stop_time) {
@@ -443,6 +826,10 @@ bool Fluorometer::OJIP_phase_4_Post_processing(uint64_t start_time, uint64_t sto
     adc_run(false);
     adc_init();
 
+    if (Merge_wraps()) {
+        Logger::Notice("Merged wraps of long intervals into {} samples", OJIP_data.sample_count);
+    }
+
     if (OJIP_data.sample_time_us[0] > OJIP_data.sample_time_us.back()) {
         Logger::Warning("Timer crosses 32-bit boundary, needs adjusting");
     }
@@ -466,8 +853,6 @@ bool Fluorometer::OJIP_phase_4_Post_processing(uint64_t start_time, uint64_t sto
         Logger::Warning("No valid samples captured, skipping filtering");
     }
 
-    ojip_capture_finished = true;
-
     return true;
 }
 
@@ -527,44 +912,37 @@ void Fluorometer::Print_curve_data(OJIP * data){
     }
 }
 
-bool Fluorometer::Receive(CAN::Message message){
+bool Fluorometer::Receive(CAN::Message const &message){
     UNUSED(message);
     return true;
 }
 
-size_t find_closest_calibration_index(std::array<uint32_t, FLUOROMETER_CALIBRATION_SAMPLES> calibration_data, uint32_t target_time_us) {
-    const auto& cal_times = calibration_data;
-    const size_t cal_size = cal_times.size();
-
-    if (cal_size == 0) {
+size_t Fluorometer::Calibration_cursor::Closest(uint32_t target_time_us) {
+    if (timing_us.empty()) {
         return 0; // No calibration data
     }
 
-    // Use lower_bound to find the first element not less than target_time_us
-    auto it = std::lower_bound(cal_times.begin(), cal_times.end(), target_time_us);
-
-    // Handle edge cases: target_time_us is before the first element
-    if (it == cal_times.begin()) {
-        return 0;
+    // Samples are walked in order, lower timestamp is unexpected (timer overflow), cursor is placed by binary search
+    if ((index > 0) and (target_time_us < timing_us[index])) {
+        auto it = std::upper_bound(timing_us.begin(), timing_us.end(), target_time_us);
+        index = (it == timing_us.begin()) ? 0 : std::distance(timing_us.begin(), it) - 1;
     }
 
-    // Handle edge cases: target_time_us is after the last element
-    if (it == cal_times.end()) {
-        return cal_size - 1;
+    // Move to last calibration point not after target
+    while ((index + 1 < timing_us.size()) and (timing_us[index + 1] <= target_time_us)) {
+        index++;
     }
 
-    // We are between two elements: *(it-1) and *it
-    // Check which one is closer
-    uint32_t time_before = *(it - 1);
-    uint32_t time_after = *it;
-    size_t index_before = std::distance(cal_times.begin(), it - 1);
+    // Target is before first point or after last point
+    if ((target_time_us <= timing_us[index]) or (index + 1 == timing_us.size())) {
+        return index;
+    }
 
-    if ((target_time_us - time_before) < (time_after - target_time_us)) {
-        // Closer to the element before
-        return index_before;
+    // We are between two points, check which one is closer
+    if ((target_time_us - timing_us[index]) < (timing_us[index + 1] - target_time_us)) {
+        return index;
     } else {
-        // Closer to the element at or after (or equally close)
-        return index_before + 1;
+        return index + 1;
     }
 }
 
@@ -597,32 +975,23 @@ bool Fluorometer::Export_data(OJIP * data){
 
     Logger::Notice("Gain compensation: {:.2f}", gain_value);
 
+    Calibration_cursor calibration(calibration_data.timing_us);
+
 
     // Process each captured sample
     for (size_t i = 0; i < data->sample_time_us.size(); ++i) {
         uint32_t current_time_us = data->sample_time_us[i];
-        uint16_t current_intensity = data->intensity[i]; // Use raw intensity before filtering if filter applied earlier
+        uint16_t current_intensity = Corrected_intensity(data, i, gain_value, calibration);
 
-        // Apply calibration if available
         if (calibration_data.calibrated) {
-            // Find the index in calibration data with the closest timestamp
-            size_t cal_idx = find_closest_calibration_index(calibration_data.timing_us,current_time_us);
-
-            // Get the corresponding calibration ADC value
-            uint16_t correction = calibration_data.adc_value[cal_idx] / gain_value;
-
-            // Apply correction with underflow protection
-            if (current_intensity > correction) {
-                current_intensity -= correction;
+            if (current_intensity > 0) {
                 samples_calibrated++;
-            } else {
-                current_intensity = 0;
             }
 
             // Optional: Log the mapping occasionally for debugging
             if (i < 5 || i % 200 == 0 || i == data->sample_time_us.size() - 1) {
-                 Logger::Trace("Sample {:4d} (t={:8d}us) mapped to Calib {:4d} (t={:8d}us), Corr: {:4d}",
-                               i, current_time_us, cal_idx, calibration_data.timing_us[cal_idx], correction);
+                 Logger::Trace("Sample {:4d} (t={:8d}us) raw: {:4d}, corrected: {:4d}",
+                               i, current_time_us, data->intensity[i], current_intensity);
             }
         }
 
@@ -630,26 +999,158 @@ bool Fluorometer::Export_data(OJIP * data){
         sample.time_us = current_time_us;
         sample.sample_value = current_intensity; // Use the (potentially) calibrated value
 
-        // Send message and manage CAN queue
-        uint queue = Send_CAN_message(sample);
+        // Wait for free space in bulk queue instead of dropping samples, bus is saturated without busy-waiting
+        if (not Send_CAN_message_blocking(sample, CAN::TX_priority::Bulk, 100)) {
+            Logger::Error("OJIP export stalled at sample {}, CAN bus is not transmitting", i);
+            return false;
+        }
         samples_sent++;
+    }
+
+    Logger::Notice("OJIP export complete: {}/{} samples sent, {} calibrated",
+                samples_sent, data->sample_time_us.size(), samples_calibrated);
+
+    return true;
+}
+
+bool Fluorometer::Export_conversion_counts(OJIP * data){
+    const size_t sample_count = data->conversions.size();
+    const size_t counts_per_frame = 3;
+
+    for (size_t first = 0; first < sample_count; first += counts_per_frame) {
+        etl::vector<uint8_t, 8> frame_data = {
+            static_cast<uint8_t>(first >> 8),
+            static_cast<uint8_t>(first),
+        };
+        for (size_t index = first; (index < sample_count) and (index < first + counts_per_frame); index++) {
+            frame_data.push_back(static_cast<uint8_t>(data->conversions[index] >> 8));
+            frame_data.push_back(static_cast<uint8_t>(data->conversions[index]));
+        }
+
+        Application_message frame(Codes::Message_type::Fluorometer_OJIP_bin_counts, frame_data);
+        if (not Send_CAN_message_blocking(frame, CAN::TX_priority::Bulk, 100)) {
+            Logger::Error("OJIP conversion counts export stalled at sample {}, CAN bus is not transmitting", first);
+            return false;
+        }
+    }
+
+    Logger::Notice("OJIP conversion counts export complete: {} samples", sample_count);
+    return true;
+}
+
+bool Fluorometer::Set_capture_options(Application_message const &message){
+    if (message.data.size() < 1) {
+        Logger::Error("Fluorometer OJIP capture options without flags");
+        return false;
+    }
 
-        // Manage CAN queue to prevent overflow
-        if (queue > 48) {
-            rtos::Delay(1);
-            if ((i % 100) == 0) {
-                Logger::Warning("CAN queue high level");
+    if (not ojip_capture_finished) {
+        Logger::Warning("Fluorometer OJIP capture in progress, options not changed");
+        return false;
+    }
+
+    capture_options.bin_averaging = message.data[0] & 0x01;
+    capture_options.send_parameters = message.data[0] & 0x02;
+    capture_options.repetitions = (message.data.size() > 1) ? std::max<uint8_t>(message.data[1], 1) : 1;
+    capture_options.dark_adaptation_s = (message.data.size() > 3) ? ((message.data[2] << 8) | message.data[3]) : 0;
+
+    Logger::Notice("Fluorometer OJIP capture options: bin averaging {}, repetitions {}, dark adaptation {} s, send parameters {}",
+        capture_options.bin_averaging ? "on" : "off", capture_options.repetitions, capture_options.dark_adaptation_s,
+        capture_options.send_parameters ? "on" : "off");
+    return true;
+}
+
+uint16_t Fluorometer::Corrected_intensity(OJIP * data, size_t index, float gain_compensation, Calibration_cursor &calibration) const{
+    uint16_t intensity = data->intensity[index];
+
+    if (not calibration_data.calibrated) {
+        return intensity;
+    }
+
+    // Find the index in calibration data with the closest timestamp
+    size_t cal_idx = calibration.Closest(data->sample_time_us[index]);
+
+    // Get the corresponding calibration ADC value
+    uint16_t correction = calibration_data.adc_value[cal_idx] / gain_compensation;
+
+    // Apply correction with underflow protection
+    if (intensity > correction) {
+        return intensity - correction;
+    } else {
+        return 0;
+    }
+}
+
+bool Fluorometer::Export_data_packed(OJIP * data){
+    if (data->sample_time_us.size() != data->intensity.size()) {
+         Logger::Error("OJIP sample intensity and timestamp vectors have different sizes");
+         return false;
+    }
+
+    const size_t sample_count = data->intensity.size();
+
+    if (not calibration_data.calibrated) {
+        Logger::Warning("Calibration data invalid or missing, exporting raw data.");
+    }
+
+    watchdog_update();
+
+    float gain_value = Fluorometer_config::gain_values.at(calibration_data.gain) / Fluorometer_config::gain_values.at(data->detector_gain);
+    Calibration_cursor calibration(calibration_data.timing_us);
+
+    // Header carries timing profile, receiver regenerates sample timestamps from it
+    uint16_t length_ms = static_cast<uint16_t>(std::clamp(data->sample_range * 1000.0f, 0.0f, 65535.0f));
+    uint8_t intensity = static_cast<uint8_t>(std::clamp(data->emitor_intensity, 0.0f, 1.0f) * 255.0f);
+
+    etl::vector<uint8_t, 8> header_data = {
+        data->measurement_id,
+        static_cast<uint8_t>((static_cast<uint8_t>(data->timing) << 4) | (static_cast<uint8_t>(data->detector_gain) & 0x0f)),
+        static_cast<uint8_t>(sample_count >> 8),
+        static_cast<uint8_t>(sample_count),
+        static_cast<uint8_t>(length_ms >> 8),
+        static_cast<uint8_t>(length_ms),
+        intensity,
+        static_cast<uint8_t>(packed_samples_per_frame),
+    };
+
+    Application_message header(Codes::Message_type::Fluorometer_OJIP_packed_header, header_data);
+    if (not Send_CAN_message_blocking(header, CAN::TX_priority::Bulk, 100)) {
+        Logger::Error("OJIP packed export stalled at header, CAN bus is not transmitting");
+        return false;
+    }
+
+    size_t frames_sent = 0;
+
+    for (size_t first = 0; first < sample_count; first += packed_samples_per_frame) {
+        uint64_t packed = static_cast<uint64_t>(frames_sent & 0x0f) << 60;
+
+        for (size_t slot = 0; slot < packed_samples_per_frame; ++slot) {
+            uint16_t value = 0;
+            if ((first + slot) < sample_count) {
+                value = std::min<uint16_t>(Corrected_intensity(data, first + slot, gain_value, calibration), 0x0fff);
             }
+            packed |= static_cast<uint64_t>(value) << (48 - (slot * 12));
+        }
+
+        etl::vector<uint8_t, 8> frame_data;
+        for (int byte = 7; byte >= 0; --byte) {
+            frame_data.push_back(static_cast<uint8_t>(packed >> (byte * 8)));
         }
+
+        Application_message frame(Codes::Message_type::Fluorometer_OJIP_packed_data, frame_data);
+        if (not Send_CAN_message_blocking(frame, CAN::TX_priority::Bulk, 100)) {
+            Logger::Error("OJIP packed export stalled at frame {}, CAN bus is not transmitting", frames_sent);
+            return false;
+        }
+        frames_sent++;
     }
 
-    Logger::Notice("OJIP export complete: {}/{} samples sent, {} calibrated",
-                samples_sent, data->sample_time_us.size(), samples_calibrated);
+    Logger::Notice("OJIP packed export complete: {} samples in {} frames", sample_count, frames_sent + 1);
 
     return true;
 }
 
-bool Fluorometer::Receive(Application_message message){
+bool Fluorometer::Receive(Application_message const &message){
     switch (message.Message_type()) {
         case Codes::Message_type::Fluorometer_sample_request: {
             Logger::Notice("Fluorometer sample request");
@@ -660,24 +1161,25 @@ bool Fluorometer::Receive(Application_message message){
                 return false;
             }
 
-            uint8_t measurement_id = sample_request.measurement_id;
-            Gain(sample_request.detector_gain);
-            Emitor_intensity(sample_request.emitor_intensity);
-            rtos::Delay(50);
+            // Settling of emitor and detector takes time, sample is acquired by job executor
+            return Defer([this, sample_request](){
+                Gain(sample_request.detector_gain);
+                Emitor_intensity(sample_request.emitor_intensity);
+                rtos::Delay(50);
 
-            uint16_t sample_value = Detector_raw_value();
+                uint16_t sample_value = Detector_raw_value();
 
-            Logger::Notice("Sample value: {:5.3f}, raw: {:4d}", Detector_value(sample_value), sample_value);
+                Logger::Notice("Sample value: {:5.3f}, raw: {:4d}", Detector_value(sample_value), sample_value);
 
-            App_messages::Fluorometer::Sample_response sample_response;
-            sample_response.measurement_id = measurement_id;
-            sample_response.sample_value = sample_value;
-            sample_response.gain = Gain();
-            sample_response.emitor_intensity = Emitor_intensity();
+                App_messages::Fluorometer::Sample_response sample_response;
+                sample_response.measurement_id = sample_request.measurement_id;
+                sample_response.sample_value = sample_value;
+                sample_response.gain = Gain();
+                sample_response.emitor_intensity = Emitor_intensity();
 
-            Send_CAN_message(sample_response);
-            Emitor_intensity(0.0);
-            return true;
+                Send_CAN_message(sample_response);
+                Emitor_intensity(0.0);
+            });
         }
 
         case Codes::Message_type::Fluorometer_OJIP_capture_request: {
@@ -685,6 +1187,23 @@ bool Fluorometer::Receive(Application_message message){
             return fluorometer_thread->Enqueue_message(message);
         }
 
+        case Codes::Message_type::Fluorometer_OJIP_capture_options_request: {
+            return Set_capture_options(message);
+        }
+
+        case Codes::Message_type::Fluorometer_OJIP_parameters_request: {
+            if (not ojip_capture_finished) {
+                Logger::Warning("Fluorometer OJIP capture in progress");
+                return false;
+            }
+            return Send_OJIP_parameters();
+        }
+
+        case Codes::Message_type::Fluorometer_OJIP_bin_counts_request: {
+            Logger::Notice("Fluorometer OJIP conversion counts request enqueued");
+            return fluorometer_thread->Enqueue_message(message);
+        }
+
         case Codes::Message_type::Fluorometer_OJIP_completed_request: {
             Logger::Notice("Fluorometer OJIP finished request");
             App_messages::Fluorometer::OJIP_completed_response response(ojip_capture_finished);
@@ -697,6 +1216,11 @@ bool Fluorometer::Receive(Application_message message){
             return fluorometer_thread->Enqueue_message(message);
         }
 
+        case Codes::Message_type::Fluorometer_OJIP_retrieve_packed_request: {
+            Logger::Notice("Fluorometer OJIP packed retrieve request enqueued");
+            return fluorometer_thread->Enqueue_message(message);
+        }
+
         case Codes::Message_type::Fluorometer_detector_info_request: {
             Logger::Notice("Fluorometer detector info request");
             App_messages::Fluorometer::Detector_info_response response(700, 1, 500);
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <ranges>
+#include <span>
 
 #include "can_bus/app_message.hpp"
 #include "can_bus/message_receiver.hpp"
@@ -21,6 +22,8 @@
 #include "hal/pwm/pwm.hpp"
 #include "logger.hpp"
 #include "mutex.hpp"
+#include "semaphore.hpp"
+#include "ticks.hpp"
 #include "rtos/wrappers.hpp"
 #include "etl/map.h"
 #include "etl/vector.h"
@@ -29,6 +32,8 @@
 #include "hardware/adc.h"
 #include "hardware/pwm.h"
 #include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "pico/time.h"
 #include "hardware/watchdog.h"
 
 #include "codes/messages/fluorometer/fluorometer_config.hpp"
@@ -58,9 +63,11 @@ typedef std::function<bool(etl::vector<uint32_t, FLUOROMETER_MAX_SAMPLES>&,uint,
  *          Measurement is composed of five phases:
  *              Phase 0: Preparation        - Initialize memory and compute timing
  *              Phase 1: Configuration      - Setup ADC, timer, DMA
- *              Phase 2: Fast phase         - Perform fast sampling of signal and clock timestamps using DMA
- *              Phase 3: Slow phase         - Perform slow sampling of signal using timer alarm
+ *              Phase 2: Capture            - Start sampling of signal and clock timestamps paced by PWM wraps using DMA
+ *              Phase 3: Completion         - Sleep until DMA transfers last sample, release DMA channels
  *              Phase 4: Post-processing    - Process data (filter, calibrate, align) and clean up
+ *              Phase 5: Parameters         - Compute characteristic points of curve (Fo, Fj, Fi, Fm, Fv/Fm, area),
+ *                                            only for measurement requests, not for calibration
  */
 class Fluorometer: public Component, public Message_receiver {
     friend class Fluorometer_thread;
@@ -72,8 +79,52 @@ public:
         Fluorometer_config::Gain detector_gain;
         float sample_range;
         uint32_t sample_count;
+        Fluorometer_config::Timing timing;
         etl::vector<uint32_t, FLUOROMETER_MAX_SAMPLES> sample_time_us;
         etl::vector<uint16_t, FLUOROMETER_MAX_SAMPLES> intensity;
+        etl::vector<uint16_t, FLUOROMETER_MAX_SAMPLES> conversions;    // ADC conversions averaged in sample (saturated), 1 without bin averaging
+    };
+
+    /**
+     * @brief   Options of OJIP capture, applied to all following captures
+     *          Fluorometer_OJIP_capture_options_request data: [0] flags (bit 0 - bin averaging, bit 1 - send parameters), optional:
+     *              [1] number of repetitions (0 and 1 - single capture), [2-3] dark adaptation between repetitions in seconds (big-endian)
+     */
+    struct Capture_options {
+        bool        bin_averaging       = false;    // Sample is mean of all ADC conversions between previous and current sample time
+        uint8_t     repetitions         = 1;        // Captures averaged on device into single exported curve
+        uint16_t    dark_adaptation_s   = 0;        // Delay with emitor off before each repeated capture
+        bool        send_parameters     = false;    // Parameters of curve are sent after capture, export of curve is not needed
+    };
+
+    /**
+     * @brief   Characteristic points of OJIP curve and derived ratios (JIP-test), computed from filtered and calibrated curve
+     *          Sent as burst of Fluorometer_OJIP_parameters frames: [0] measurement id, [1] field, [2-5] value (big-endian)
+     *          Fields: 0 - Fo, 1 - Fj, 2 - Fi, 3 - Fm, 4 - time of Fm (us), 5 - Fv/Fm (x10000),
+     *                  6 - area between curve and Fm from start to time of Fm (intensity * ms)
+     */
+    struct OJIP_parameters {
+        bool        valid       = false;
+        uint16_t    fo          = 0;    // Intensity at 20 us
+        uint16_t    fj          = 0;    // Intensity at 2 ms
+        uint16_t    fi          = 0;    // Intensity at 30 ms
+        uint16_t    fm          = 0;    // Maximal intensity
+        uint32_t    fm_time_us  = 0;
+        float       fv_fm       = 0.0f; // Maximal quantum yield of PSII, (Fm - Fo) / Fm
+        uint32_t    area        = 0;
+    };
+
+    /**
+     * @brief   Identifiers of fields in parameters response
+     */
+    enum class OJIP_parameter: uint8_t {
+        Fo      = 0x00,
+        Fj      = 0x01,
+        Fi      = 0x02,
+        Fm      = 0x03,
+        Fm_time = 0x04,
+        Fv_Fm   = 0x05,
+        Area    = 0x06,
     };
 
     struct Calibration_data{
@@ -87,6 +138,37 @@ public:
         const Fluorometer_config::Timing timing;
     };
 
+    /**
+     * @brief   Finds calibration point closest in time to sample
+     *          Sample and calibration timestamps are both sorted, so cursor only moves forward while samples are walked
+     *              and whole export is aligned in single pass over calibration (merge-walk)
+     *          Timestamp lower than previous one moves cursor back by binary search
+     */
+    class Calibration_cursor {
+    private:
+        std::span<const uint32_t> timing_us;
+
+        size_t index = 0;
+
+    public:
+        /**
+         * @brief Construct a new cursor at first calibration point
+         *
+         * @param timing_us     Sorted timestamps of calibration points, must outlive cursor
+         */
+        explicit Calibration_cursor(std::span<const uint32_t> timing_us):
+            timing_us(timing_us)
+        { };
+
+        /**
+         * @brief   Index of calibration point closest to timestamp, on tie later point is selected
+         *
+         * @param target_time_us    Timestamp of sample
+         * @return size_t           Index of closest calibration point
+         */
+        size_t Closest(uint32_t target_time_us);
+    };
+
 private:
 
     /**
@@ -118,10 +200,17 @@ private:
     const uint adc_input_channel = 1;
 
     /**
-     * @brief   Timer slice clock divider for PWM triggering sampling ion fast phase
+     * @brief   Timer slice clock divider for PWM triggering sampling, base resolution of capture timing
      */
     static inline const uint32_t timer_clock_divider = 10;
 
+    /**
+     * @brief   Long intervals between samples are counted with higher divider, up to maximal integer part of PWM divider
+     *          Longest wrap is 65536 * 255 cycles of system clock (83.9 ms at 200 MHz),
+     *              longer interval is split into multiple equal wraps and only last of them is kept as sample
+     */
+    static inline const uint32_t max_timer_clock_divider = 255;
+
     /**
      * @brief   Slice of timer PWM which triggers sampling (whole slice isused)
      */
@@ -136,9 +225,113 @@ private:
     /**
      * @brief   Vector holding capture times of OJIP curve samples as micro seconds delays between captures
      *          Capture at 1ms, 5ms 15ms -> 1, 4, 10
+     *          Converted by Prescale_timing into wrap values of sampler trigger slice, one entry per wrap
      */
     inline static etl::vector<uint32_t, FLUOROMETER_MAX_SAMPLES> capture_timing;
 
+    /**
+     * @brief   Values of PWM divider register for each wrap of sampler trigger slice, written by DMA together with capture timing
+     *          16-bit transfers are replicated over whole register by bus, only lower 12 bits are used by divider
+     */
+    inline static etl::vector<uint16_t, FLUOROMETER_MAX_SAMPLES> capture_divider;
+
+    /**
+     * @brief   Number of wraps of sampler trigger slice in interval of each sample, more than one for intervals longer than single wrap
+     *          ADC and timestamp are captured at every wrap, intermediate wraps are merged into sample during post-processing
+     */
+    inline static etl::vector<uint16_t, FLUOROMETER_MAX_SAMPLES> sample_wraps;
+
+    /**
+     * @brief   Expected duration of whole OJIP capture
+     */
+    inline static uint64_t capture_duration_us = 0;
+
+    /**
+     * @brief   Given from DMA interrupt when last sample of OJIP capture is transferred
+     */
+    inline static fra::BinarySemaphore * capture_done = nullptr;
+
+    /**
+     * @brief   DMA channel which completion signalizes end of capture, -1 when no capture is running
+     */
+    inline static volatile int capture_completion_channel = -1;
+
+    /**
+     * @brief   Time of completion of capture, captured in DMA interrupt
+     */
+    inline static volatile uint64_t capture_stop_time = 0;
+
+    /**
+     * @brief   Flag if handler of DMA interrupt is already registered
+     */
+    inline static bool capture_irq_registered = false;
+
+    /**
+     * @brief   Options of next OJIP capture
+     */
+    inline static Capture_options capture_options = {};
+
+    /**
+     * @brief   Sum of intensities of repeated captures, averaged into OJIP data after last repetition
+     */
+    inline static etl::vector<uint32_t, FLUOROMETER_MAX_SAMPLES> intensity_accumulator;
+
+    /**
+     * @brief   Parameters of last captured curve
+     */
+    inline static OJIP_parameters OJIP_parameters_data = {};
+
+    /**
+     * @brief   Times of characteristic points of OJIP curve
+     */
+    static constexpr uint32_t fo_time_us = 20;
+    static constexpr uint32_t fj_time_us = 2000;
+    static constexpr uint32_t fi_time_us = 30000;
+
+    /**
+     * @brief   Size of ring for free-running ADC conversions in bin averaging mode, ring buffer of DMA must be aligned to its size
+     */
+    static constexpr uint conversion_ring_bits = 12;
+    static constexpr size_t conversion_ring_samples = (1 << conversion_ring_bits) / sizeof(uint16_t);
+
+    /**
+     * @brief   Period of draining of conversion ring, ring must not be filled by ADC within this period
+     */
+    static constexpr int64_t conversion_ring_drain_us = 250;
+
+    /**
+     * @brief   Ring filled by DMA with every conversion of ADC during bin averaging capture
+     */
+    alignas(1 << conversion_ring_bits) inline static std::array<uint16_t, conversion_ring_samples> conversion_ring;
+
+    /**
+     * @brief   DMA channel filling conversion ring, -1 when bin averaging is not running
+     */
+    inline static int conversion_ring_channel = -1;
+
+    /**
+     * @brief   DMA channel storing position in conversion ring at end of each bin, completes with last bin
+     */
+    inline static int bin_boundary_channel = -1;
+
+    /**
+     * @brief   Accumulation of conversions into bins, processed from timer interrupt
+     */
+    struct Bin_accumulator {
+        uint32_t    processed   = 0;    // Number of conversions from start of ring channel already accumulated
+        uint64_t    sum         = 0;
+        uint32_t    count       = 0;
+        size_t      bin         = 0;    // Index of currently open bin
+        uint32_t    overruns    = 0;    // Number of drains which found ring overwritten
+    };
+
+    inline static Bin_accumulator bin_accumulator = {};
+
+    /**
+     * @brief   Timer draining conversion ring during bin averaging capture
+     */
+    inline static repeating_timer_t conversion_ring_timer;
+
     /**
      * @brief   ADC channel for measuring detector output, used only for single samples
      */
@@ -204,7 +397,8 @@ public:
     Fluorometer(PWM_channel * led_pwm, uint detector_gain_pin, GPIO * ntc_channel_selector, Thermistor * ntc_thermistors, I2C_bus * const i2c, EEPROM_storage * const memory, fra::MutexStandard * cuvette_mutex, fra::MutexStandard * const adc_mutex);
 
     /**
-     * @brief
+     * @brief   Capture OJIP curve, with repetitions in capture options curves are averaged on device
+     *          Timestamps and conversion counts are kept from last repetition
      *
      * @param gain              Gain of detector
      * @param emitor_intensity  Intensity of emitor LED in range 0.1-1.0f
@@ -242,7 +436,7 @@ public:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(CAN::Message message) override final;
+    virtual bool Receive(CAN::Message const &message) override final;
 
         /**
      * @brief   Receive message implementation from Message_receiver interface for Application messages (extended frame)
@@ -252,7 +446,7 @@ public:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(Application_message message) override final;
+    virtual bool Receive(Application_message const &message) override final;
 
     /**
      * @brief   Get temperature of emitor LED
@@ -418,12 +612,60 @@ private:
      */
     bool Export_data(OJIP * data);
 
+    /**
+     * @brief       Export data over CAN bus in packed format, header frame with timing profile followed by data frames
+     *              Header frame (Fluorometer_OJIP_packed_header), multi-byte values are big-endian:
+     *                  [0] measurement id, [1] timing type (high nibble) and detector gain (low nibble),
+     *                  [2-3] sample count, [4-5] capture length in ms, [6] emitor intensity (0-255), [7] samples per data frame
+     *              Data frame (Fluorometer_OJIP_packed_data), 64 bits read as big-endian:
+     *                  4 bit sequence number (frame index modulo 16) followed by 5 samples of 12 bits
+     *              Timestamps are not transferred, receiver regenerates them from timing profile in header
+     *
+     * @param data      Pointer to OJIP data
+     * @return true     Data was exported successfully
+     * @return false    Data was not exported, invalid data or CAN bus stalled
+     */
+    bool Export_data_packed(OJIP * data);
+
+    /**
+     * @brief   Number of 12 bit samples carried by one packed data frame
+     */
+    static constexpr uint packed_samples_per_frame = 5;
+
+    /**
+     * @brief       Export number of ADC conversions averaged in each sample of last capture
+     *              Burst of Fluorometer_OJIP_bin_counts frames, multi-byte values are big-endian:
+     *                  [0-1] index of first sample in frame, [2-7] up to 3 counts of conversions (16-bit, saturated)
+     *
+     * @param data      Pointer to OJIP data
+     * @return true     Counts were exported successfully
+     * @return false    Counts were not exported, CAN bus stalled
+     */
+    bool Export_conversion_counts(OJIP * data);
+
+    /**
+     * @brief       Intensity of sample with calibration offset subtracted (if calibration is available)
+     *
+     * @param data              Pointer to OJIP data
+     * @param index             Index of sample
+     * @param gain_compensation Ratio between gain of calibration and gain of measurement
+     * @param calibration       Cursor over calibration timestamps, shared by all samples of export
+     * @return uint16_t         Corrected intensity of sample
+     */
+    uint16_t Corrected_intensity(OJIP * data, size_t index, float gain_compensation, Calibration_cursor &calibration) const;
+
     inline static etl::map<Fluorometer_config::Timing, Timing_generator_interface, 16> timing_generators = {
         {Fluorometer_config::Timing::Linear, Timing_generator_linear},
         {Fluorometer_config::Timing::Logarithmic, Timing_generator_logarithmic}
     };
 
 private:
+    /**
+     * @brief Single OJIP capture, phases 0 to 4
+     * @return true if capture was successful, false otherwise
+     */
+    bool Capture_OJIP_single(Fluorometer_config::Gain gain, float emitor_intensity, float capture_length, uint samples, Fluorometer_config::Timing timing);
+
     /**
      * @brief OJIP Phase 0: Preparation - Initialize memory and compute timing
      * @param gain Detector gain
@@ -434,32 +676,100 @@ private:
      */
     bool OJIP_phase_0_Preparation(Fluorometer_config::Gain gain, float emitor_intensity, float capture_length, Fluorometer_config::Timing timing);
 
+    /**
+     * @brief Convert capture timing in microseconds to pairs of PWM wrap value and divider
+     *        Intervals which do not fit into 16-bit counter with base divider are counted with smallest sufficient divider,
+     *        intervals longer than single wrap with maximal divider are split into equal wraps (sample_wraps)
+     * @param sys_clock_hz Frequency of system clock which drives PWM
+     * @return true if timing was converted, false if number of wraps exceeds capacity of capture buffers
+     */
+    bool Prescale_timing(uint32_t sys_clock_hz);
+
+    /**
+     * @brief Merge data captured at every wrap into samples, only last wrap of each interval is kept
+     *        In bin averaging mode sample is mean of conversions of all wraps of its interval
+     * @return true if wraps were merged, false if every interval was captured by single wrap
+     */
+    bool Merge_wraps();
+
     /**
      * @brief OJIP Phase 1: Configuration - Set up hardware (ADC, PWM, DMA)
      * @param timestamp_dma_channel Reference to timestamp DMA channel
      * @param wrap_dma_channel Reference to wrap DMA channel
+     * @param divider_dma_channel Reference to divider DMA channel
      * @param adc_dma_channel Reference to ADC DMA channel
-     * @param fast_phase_samples Number of samples in fast phase
      * @return true if configuration succeeds, false otherwise
      */
-    bool OJIP_phase_1_Configuration(int& timestamp_dma_channel, int& wrap_dma_channel, int& adc_dma_channel, int fast_phase_samples);
+    bool OJIP_phase_1_Configuration(int& timestamp_dma_channel, int& wrap_dma_channel, int& divider_dma_channel, int& adc_dma_channel);
+
+    /**
+     * @brief OJIP Phase 2: Capture - Start DMA-paced sampling of whole capture
+     * @return Start time in microseconds
+     */
+    uint64_t OJIP_phase_2_Capture();
 
     /**
-     * @brief OJIP Phase 2: Fast phase - Perform DMA-based fast sampling
+     * @brief OJIP Phase 3: Completion - Sleep until DMA transfers last sample, then release DMA channels
      * @param timestamp_dma_channel Timestamp DMA channel
      * @param wrap_dma_channel Wrap DMA channel
+     * @param divider_dma_channel Divider DMA channel
      * @param adc_dma_channel ADC DMA channel
-     * @return Start time in microseconds
+     * @param stop_time Time of last sample in microseconds
+     * @return true if all samples were captured, false on timeout
+     */
+    bool OJIP_phase_3_Completion(int timestamp_dma_channel, int wrap_dma_channel, int divider_dma_channel, int adc_dma_channel, uint64_t &stop_time);
+
+    /**
+     * @brief OJIP Phase 5: Parameters - Compute characteristic points and ratios of filtered and calibrated curve
+     * @return true if curve contains valid maximum, false otherwise
      */
-    uint64_t OJIP_phase_2_Fast_phase(int timestamp_dma_channel, int wrap_dma_channel, int adc_dma_channel);
+    bool OJIP_phase_5_Parameters();
+
+    /**
+     * @brief Send parameters of last captured curve as burst of Fluorometer_OJIP_parameters frames
+     * @return true if parameters are valid and were sent, false otherwise
+     */
+    bool Send_OJIP_parameters();
+
+    /**
+     * @brief DMA interrupt handler, signalizes completion of capture
+     */
+    static void Capture_complete_IRQ();
+
+    /**
+     * @brief Configure DMA channels of bin averaging, ADC conversions are streamed into ring
+     *        and position in ring at each wrap of sampler trigger is written to intensity buffer as bin boundary
+     * @param adc_dma_channel ADC DMA channel, reconfigured to capture bin boundaries
+     * @return true if configuration succeeds, false otherwise
+     */
+    bool Configure_bin_averaging(int adc_dma_channel);
+
+    /**
+     * @brief Accumulate conversions from ring into bins, closed bins are replaced by mean of their conversions
+     *        Bin boundaries are stored by DMA as lower 16 bits of remaining transfers of ring channel,
+     *        ring is drained often enough that boundary is never more than 65535 conversions old
+     * @return true if some bins are still open
+     */
+    static bool Drain_conversion_ring();
+
+    /**
+     * @brief Timer callback draining conversion ring during capture
+     */
+    static bool Conversion_ring_timer_callback(repeating_timer_t *timer);
+
+    /**
+     * @brief Number of conversions written into conversion ring since start of ring channel
+     */
+    static uint32_t Conversion_ring_position(){
+        return ~dma_channel_hw_addr(conversion_ring_channel)->transfer_count;
+    };
 
     /**
-     * @brief OJIP Phase 3: Slow phase - Perform alarm-based slow sampling
-     * @param ticks_per_us Ticks per microsecond
-     * @param fast_phase_samples Number of samples in fast phase
-     * @return Stop time in microseconds
+     * @brief Set options of following captures
+     * @param message Fluorometer_OJIP_capture_options_request
+     * @return true if options were applied, false when message is malformed or capture is running
      */
-    uint64_t OJIP_phase_3_Slow_phase(uint32_t ticks_per_us, int fast_phase_samples);
+    bool Set_capture_options(Application_message const &message);
 
     /**
      * @brief OJIP Phase 4: Post-processing - Process data and clean up
@@ -5,11 +5,16 @@ Heater::Heater(uint gpio_in1, uint gpio_in2, float pwm_frequency):
     Message_receiver(Codes::Component::Bottle_heater),
     control_bridge(new DC_HBridge_PIO(gpio_in1, gpio_in2, PIO_machine(pio0,3), pwm_frequency)),
     heater_sensor(new Thermistor(new ADC_channel(ADC_channel::RP2040_ADC_channel::CH_3, 3.30f), 3950, 100000, 25, 30000)),
-    heater_fan(new GPIO(11, GPIO::Direction::Out))
+    heater_fan(new GPIO(11, GPIO::Direction::Out)),
+    bottle_temperature_subscription(Codes::Module::Sensor_module, Codes::Instance::Exclusive, Codes::Message_type::Bottle_temperature_request, 2500)
 {
     control_bridge->Coast();
     heater_fan->Set(false);
 
+    Value_registry::Register(Value_registry::Value_id::Heater_intensity, Component_type(), [this](){ return std::optional<float>(Intensity()); });
+    Value_registry::Register(Value_registry::Value_id::Heater_target_temperature, Component_type(), [this](){ return target_temperature; });
+    Value_registry::Register(Value_registry::Value_id::Heater_plate_temperature, Component_type(), [this](){ return std::optional<float>(Temperature()); });
+
     // Register messages to received for regulator
     Message_router::Register_bypass(Codes::Message_type::Bottle_temperature_response, Codes::Component::Bottle_heater);
 
@@ -24,6 +29,7 @@ void Heater::Regulation_loop() {
     if (!target_temperature.has_value()) {
         Logger::Notice("No target temperature set, regulation disabled");
         regulation_loop->Disable();
+        bottle_temperature_subscription.Cancel();
         integral_error = 0.0f;  // Reset integral when regulation is disabled
         return;
     }
@@ -80,6 +86,7 @@ void Heater::Regulation_loop() {
     } else {
         Logger::Warning("No bottle temperature received, regulation disabled");
         Intensity(0);
+        Request_bottle_temperature();
         return;
     }
 
@@ -139,17 +146,17 @@ void Heater::Turn_off(){
     Intensity(0);
 }
 
-bool Heater::Receive(CAN::Message message){
+bool Heater::Receive(CAN::Message const &message){
     UNUSED(message);
     return true;
 }
 
 bool Heater::Request_bottle_temperature(){
-    Application_message temp_request(Codes::Module::Sensor_module, Codes::Instance::Exclusive, Codes::Message_type::Bottle_temperature_request);
-    return Send_CAN_message(temp_request);
+    // Sensor module pushes temperature periodically, request is sent only when lease of subscription needs renewal
+    return bottle_temperature_subscription.Renew();
 }
 
-bool Heater::Receive(Application_message message){
+bool Heater::Receive(Application_message const &message){
     switch (message.Message_type()){
         case Codes::Message_type::Heater_set_intensity:{
             App_messages::Heater::Set_intensity set_intensity;
@@ -193,11 +200,12 @@ bool Heater::Receive(Application_message message){
         }
 
         case Codes::Message_type::Heater_get_plate_temperature_request:{
-            float temp = Temperature();
-            Logger::Debug("Heater plate temperature: {:05.2f}˚C", temp);
-            App_messages::Heater::Get_plate_temperature_response plate_temperature(temp);
-            Send_CAN_message(plate_temperature);
-            return true;
+            return Defer([this](){
+                float temp = Temperature();
+                Logger::Debug("Heater plate temperature: {:05.2f}˚C", temp);
+                App_messages::Heater::Get_plate_temperature_response plate_temperature(temp);
+                Send_CAN_message(plate_temperature);
+            });
         }
 
         case Codes::Message_type::Heater_turn_off:{
@@ -11,6 +11,7 @@
 
 #include "can_bus/message_receiver.hpp"
 #include "can_bus/message_router.hpp"
+#include "can_bus/telemetry_service.hpp"
 #include "components/component.hpp"
 #include "components/motors/dc_hbridge_pio.hpp"
 #include "components/thermometers/thermistor.hpp"
@@ -128,6 +129,12 @@ private:
      */
     std::optional<float> bottle_temperature = std::nullopt;
 
+    /**
+     * @brief   Subscription of bottle temperature pushed by sensor module
+     *          Period is half of regulation period, so every regulation step has fresh value
+     */
+    Telemetry_subscription bottle_temperature_subscription;
+
 public:
     /**
      * @brief Construct a new Heater object
@@ -175,10 +182,10 @@ private:
     float Compensate_intensity(float requested_intensity);
 
     /**
-     * @brief  Sends request for bottle temperature used to regulate heater
+     * @brief  Subscribe bottle temperature used to regulate heater or renew existing subscription
      *
-     * @return true     Request was sent
-     * @return false    Request was not sent
+     * @return true     Subscription is active
+     * @return false    Subscription request was not sent
      */
     bool Request_bottle_temperature();
 
@@ -200,7 +207,7 @@ protected:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(CAN::Message message) override final;
+    virtual bool Receive(CAN::Message const &message) override final;
 
     /**
      * @brief   Receive message implementation from Message_receiver interface for Application messages (extended frame)
@@ -210,6 +217,6 @@ protected:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(Application_message message) override final;
+    virtual bool Receive(Application_message const &message) override final;
 
 };
@@ -7,14 +7,16 @@ LED_panel::LED_panel(std::vector<LED_intensity *> &channels, Thermistor * temp_s
     temp_sensor(temp_sensor),
     power_budget_w(power_budget_w)
 {
+    Value_registry::Register(Value_registry::Value_id::LED_panel_temperature, Component_type(), [this](){ return std::optional<float>(Temperature()); });
+    Value_registry::Register(Value_registry::Value_id::LED_panel_power_draw, Component_type(), [this](){ return std::optional<float>(Power_draw()); });
 }
 
-bool LED_panel::Receive(CAN::Message message){
+bool LED_panel::Receive(CAN::Message const &message){
     UNUSED(message);
     return true;
 }
 
-bool LED_panel::Receive(Application_message message){
+bool LED_panel::Receive(Application_message const &message){
     switch (message.Message_type()){
         case Codes::Message_type::LED_set_intensity:{
             App_messages::LED_panel::Set_intensity led_set_intensity;
@@ -26,6 +28,19 @@ bool LED_panel::Receive(Application_message message){
             return true;
         }
 
+        case Codes::Message_type::LED_set_intensity_batch:{
+            auto entries = Packed_values::Unpack(std::span<const uint8_t>(message.data.data(), message.data.size()));
+            if (not entries.has_value()){
+                Logger::Error("LED_set_intensity_batch interpretation failed");
+                return false;
+            }
+            etl::vector<std::pair<uint8_t, float>, Packed_values::max_values> setpoints;
+            for (auto const &entry : entries.value()){
+                setpoints.push_back({entry.channel, static_cast<float>(entry.raw) / Packed_values::unsigned_max});
+            }
+            return Set_intensities(setpoints);
+        }
+
         case Codes::Message_type::LED_get_intensity_request:{
             App_messages::LED_panel::Get_intensity_request led_get_intensity;
             if (!led_get_intensity.Interpret_data(message.data)){
@@ -57,6 +72,24 @@ bool LED_panel::Set_intensity(uint8_t channel, float intensity){
     return true;
 }
 
+bool LED_panel::Set_intensities(std::span<const std::pair<uint8_t, float>> setpoints){
+    for (auto const &[channel, intensity] : setpoints){
+        if (channel >= channels.size()){
+            Logger::Error("LED channel {:d} out of range, batch not applied", channel);
+            return false;
+        }
+    }
+
+    for (auto const &[channel, intensity] : setpoints){
+        channels[channel]->Intensity(intensity);
+    }
+
+    for (auto const &[channel, intensity] : setpoints){
+        Logger::Debug("Set LED intensity Channel: {:d}, Intensity: {:04.2f}", channel, intensity);
+    }
+    return true;
+}
+
 bool LED_panel::Get_intensity(uint8_t channel){
     if (channel >= channels.size()){
         Logger::Error("LED channel out of range");
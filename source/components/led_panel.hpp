@@ -8,6 +8,8 @@
 #pragma once
 
 #include <vector>
+#include <span>
+#include <utility>
 
 #include "can_bus/app_message.hpp"
 #include "can_bus/message_receiver.hpp"
@@ -23,6 +25,8 @@
 #include "components/led/led_intensity.hpp"
 #include "components/thermometers/thermistor.hpp"
 
+#include "tools/packed_values.hpp"
+
 #include "logger.hpp"
 
 /**
@@ -74,7 +78,7 @@ public:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(CAN::Message message) override final;
+    virtual bool Receive(CAN::Message const &message) override final;
 
     /**
      * @brief   Receive message implementation from Message_receiver interface for Application messages (extended frame)
@@ -84,7 +88,7 @@ public:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(Application_message message) override final;
+    virtual bool Receive(Application_message const &message) override final;
 
     /**
      * @brief   Set intensity of LED channel
@@ -96,6 +100,17 @@ public:
      */
     bool Set_intensity(uint8_t channel, float intensity);
 
+    /**
+     * @brief   Set intensity of multiple LED channels at once
+     *          All channels are validated first, intensities are then applied in single pass without yielding
+     *              so all outputs change together, nothing is applied when any channel is out of range
+     *
+     * @param setpoints Pairs of channel number and intensity from 0 to 1.0
+     * @return true     All intensities were set
+     * @return false    No intensity was set, some channel is out of range
+     */
+    bool Set_intensities(std::span<const std::pair<uint8_t, float>> setpoints);
+
     /**
      * @brief   Get intensity of LED channel
      *
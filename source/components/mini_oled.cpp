@@ -5,7 +5,9 @@ Mini_OLED::Mini_OLED(Bottle_temperature * const bottle_temp_sensor, uint32_t dat
     Message_receiver(Codes::Component::Mini_OLED),
     data_update_rate_s(data_update_rate_s),
     lvgl_thread(new Mini_display_thread()),
-    bottle_temp_sensor(bottle_temp_sensor)
+    bottle_temp_sensor(bottle_temp_sensor),
+    target_temperature_subscription(Codes::Module::Control_module, Codes::Instance::Exclusive, Codes::Message_type::Heater_get_target_temperature_request, data_update_rate_s * 1000),
+    plate_temperature_subscription(Codes::Module::Control_module, Codes::Instance::Exclusive, Codes::Message_type::Heater_get_plate_temperature_request, data_update_rate_s * 1000)
 {
 
     auto update_data_lambda = [this, data_update_rate_s](){
@@ -13,23 +15,26 @@ Mini_OLED::Mini_OLED(Bottle_temperature * const bottle_temp_sensor, uint32_t dat
           Application_message ip_request(Codes::Module::Core_module, Codes::Instance::Exclusive, Codes::Message_type::Core_IP_request);
           Application_message hostname_request(Codes::Module::Core_module, Codes::Instance::Exclusive, Codes::Message_type::Core_hostname_request);
           Application_message serial_request(Codes::Module::Core_module, Codes::Instance::Exclusive, Codes::Message_type::Core_serial_request);
-          Application_message target_temp_request(Codes::Module::Control_module, Codes::Instance::Exclusive, Codes::Message_type::Heater_get_target_temperature_request);
-          Application_message plate_temp_request(Codes::Module::Control_module, Codes::Instance::Exclusive, Codes::Message_type::Heater_get_plate_temperature_request);
 
-          Send_CAN_message(sid_request);
-          Send_CAN_message(ip_request);
-          Send_CAN_message(hostname_request);
-          Send_CAN_message(serial_request);
-          Send_CAN_message(target_temp_request);
-          Send_CAN_message(plate_temp_request);
+          // Responses are processed same way as messages routed to component, missing core module only times out
+          auto forward = [this](std::optional<Application_message> const &response){
+              if (response.has_value()) {
+                  Receive(response.value());
+              }
+          };
+
+          Request_tracker::Request(sid_request, Codes::Message_type::Core_SID_response, forward, core_response_timeout_ms);
+          Request_tracker::Request(ip_request, Codes::Message_type::Core_IP_response, forward, core_response_timeout_ms);
+          Request_tracker::Request(hostname_request, Codes::Message_type::Core_hostname_response, forward, core_response_timeout_ms);
+          Request_tracker::Request(serial_request, Codes::Message_type::Core_serial_response, forward, core_response_timeout_ms);
+
+          // Control module pushes heater values, only lease of subscription is renewed
+          target_temperature_subscription.Renew();
+          plate_temperature_subscription.Renew();
 
           Logger::Trace("Mini-OLED update messages dispatched");
       };
 
-    Message_router::Register_bypass(Codes::Message_type::Core_SID_response, Codes::Component::Mini_OLED);
-    Message_router::Register_bypass(Codes::Message_type::Core_IP_response, Codes::Component::Mini_OLED);
-    Message_router::Register_bypass(Codes::Message_type::Core_hostname_response, Codes::Component::Mini_OLED);
-    Message_router::Register_bypass(Codes::Message_type::Core_serial_response, Codes::Component::Mini_OLED);
     Message_router::Register_bypass(Codes::Message_type::Heater_get_target_temperature_response, Codes::Component::Mini_OLED);
     Message_router::Register_bypass(Codes::Message_type::Heater_get_plate_temperature_response, Codes::Component::Mini_OLED);
     Message_router::Register_bypass(Codes::Message_type::Bottle_temperature_response, Codes::Component::Mini_OLED);
@@ -37,12 +42,12 @@ Mini_OLED::Mini_OLED(Bottle_temperature * const bottle_temp_sensor, uint32_t dat
     update_data = new rtos::Repeated_execution(update_data_lambda, data_update_rate_s * 1000, true);
 }
 
-bool Mini_OLED::Receive(CAN::Message message){
+bool Mini_OLED::Receive(CAN::Message const &message){
     UNUSED(message);
     return true;
 }
 
-bool Mini_OLED::Receive(Application_message message){
+bool Mini_OLED::Receive(Application_message const &message){
     switch (message.Message_type()) {
         case Codes::Message_type::Core_SID_response: {
             App_messages::Core::SID_response sid_response;
@@ -9,6 +9,8 @@
 
 #include "can_bus/message_receiver.hpp"
 #include "can_bus/message_router.hpp"
+#include "can_bus/telemetry_service.hpp"
+#include "can_bus/request_tracker.hpp"
 #include "components/component.hpp"
 #include "components/bottle_temperature.hpp"
 #include "rtos/repeated_execution.hpp"
@@ -38,6 +40,11 @@ private:
      * @brief Rate of data update in seconds
      */
     uint32_t data_update_rate_s;
+
+    /**
+     * @brief   Maximal time to wait for response of core module
+     */
+    static constexpr uint32_t core_response_timeout_ms = 1000;
 public:
     /**
      * @brief Construct a new Mini_OLED object
@@ -61,6 +68,12 @@ public:
      */
     Bottle_temperature * const bottle_temp_sensor;
 
+    /**
+     * @brief   Subscriptions of heater values pushed by control module, renewed from update_data
+     */
+    Telemetry_subscription target_temperature_subscription;
+    Telemetry_subscription plate_temperature_subscription;
+
     /**
      * @brief   Receive message implementation from Message_receiver interface for General/Admin messages (normal frame)
      *          This method is invoked by Message_router when message is determined for this component
@@ -71,7 +84,7 @@ public:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(CAN::Message message) override final;
+    virtual bool Receive(CAN::Message const &message) override final;
 
     /**
      * @brief   Receive message implementation from Message_receiver interface for Application messages (extended frame)
@@ -81,5 +94,5 @@ public:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(Application_message message) override final;
+    virtual bool Receive(Application_message const &message) override final;
 };
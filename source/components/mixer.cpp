@@ -22,6 +22,8 @@ Mixer::Mixer(uint8_t pwm_pin, RPM_counter* tacho, float frequency, float min_rpm
     auto regulation_lambda = [this](){ this->Regulation_loop(); };
     regulation_loop = new rtos::Repeated_execution(regulation_lambda, 125, true);
 
+    Value_registry::Register(Value_registry::Value_id::Mixer_RPM, Component_type(), [this](){ return std::optional<float>(RPM()); });
+
     control = new qlibs::pidController();
 
     control->setup(0.002,0.0001,0.0,0.125);
@@ -42,12 +44,12 @@ void Mixer::Regulation_loop(){
     }
 }
 
-bool Mixer::Receive(CAN::Message message){
+bool Mixer::Receive(CAN::Message const &message){
     UNUSED(message);
     return true;
 }
 
-bool Mixer::Receive(Application_message message){
+bool Mixer::Receive(Application_message const &message){
     switch (message.Message_type()) {
         case Codes::Message_type::Mixer_set_speed: {
             App_messages::Mixer::Set_speed set_speed;
@@ -127,6 +127,13 @@ Pump_controller::Pump_controller(etl::vector<Pump *,8> pumps, EEPROM_storage * c
         }
     }, 50, true, true);
 
+    // Value IDs of pumps are consecutive
+    for (size_t index = 0; index < std::min<size_t>(pumps.size(), 4); index++) {
+        auto id = static_cast<Value_registry::Value_id>(static_cast<uint8_t>(Value_registry::Value_id::Pump_1_flowrate) + index);
+        Pump * pump = pumps[index];
+        Value_registry::Register(id, Component_type(), [pump](){ return std::optional<float>(pump->Flowrate()); });
+    }
+
     // new rtos::Repeated_execution([pumps]() {
     //     Logger::Notice("----------------------");
     //     for(uint i = 0; i < 1; i++){
@@ -157,12 +164,12 @@ void Pump_controller::Load_max_flowrates(){
     }
 }
 
-bool Pump_controller::Receive(CAN::Message message){
+bool Pump_controller::Receive(CAN::Message const &message){
     UNUSED(message);
     return true;
 }
 
-bool Pump_controller::Receive(Application_message message){
+bool Pump_controller::Receive(Application_message const &message){
     switch (message.Message_type()) {
         case Codes::Message_type::Pumps_pump_count_request: {
             App_messages::Pumps::Pump_count_response pump_count_response(Pump_count());
@@ -190,6 +197,16 @@ bool Pump_controller::Receive(Application_message message){
             return true;
         }
 
+        case Codes::Message_type::Pumps_set_speed_batch: {
+            // Speed is signed 12-bit value, full scale equals to maximal speed
+            auto setpoints = Unpack_setpoints(message.data, 1.0f / Packed_values::signed_max);
+            if (not setpoints.has_value()) {
+                Logger::Error("Pumps_set_speed_batch interpretation failed");
+                return false;
+            }
+            return Set_speeds(setpoints.value());
+        }
+
         case Codes::Message_type::Pumps_get_speed_request: {
             App_messages::Pumps::Get_speed_request get_speed_request;
             if (!get_speed_request.Interpret_data(message.data)) {
@@ -226,6 +243,16 @@ bool Pump_controller::Receive(Application_message message){
             return true;
         }
 
+        case Codes::Message_type::Pumps_set_flowrate_batch: {
+            // Flowrate is signed 12-bit value in 0.1 ml/min
+            auto setpoints = Unpack_setpoints(message.data, 0.1f);
+            if (not setpoints.has_value()) {
+                Logger::Error("Pumps_set_flowrate_batch interpretation failed");
+                return false;
+            }
+            return Set_flowrates(setpoints.value());
+        }
+
         case Codes::Message_type::Pumps_get_flowrate_request: {
             App_messages::Pumps::Get_flowrate_request get_flowrate_request;
             if (!get_flowrate_request.Interpret_data(message.data)) {
@@ -338,3 +365,56 @@ bool Pump_controller::Receive(Application_message message){
             return false;
     }
 }
+
+bool Pump_controller::Set_speeds(std::span<const std::pair<uint8_t, float>> setpoints){
+    if (not Valid_pump_indexes(setpoints)) {
+        return false;
+    }
+
+    for (auto const &[pump_index, speed] : setpoints) {
+        pumps[pump_index - 1]->Speed(speed);
+    }
+
+    for (auto const &[pump_index, speed] : setpoints) {
+        Logger::Debug("Pump {} speed set to: {:03.2f}", pump_index, speed);
+    }
+    return true;
+}
+
+bool Pump_controller::Set_flowrates(std::span<const std::pair<uint8_t, float>> setpoints){
+    if (not Valid_pump_indexes(setpoints)) {
+        return false;
+    }
+
+    for (auto const &[pump_index, flowrate] : setpoints) {
+        pumps[pump_index - 1]->Flowrate(flowrate);
+    }
+
+    for (auto const &[pump_index, flowrate] : setpoints) {
+        Logger::Debug("Pump {} flowrate set to: {:03.2f}", pump_index, flowrate);
+    }
+    return true;
+}
+
+std::optional<etl::vector<std::pair<uint8_t, float>, Packed_values::max_values>> Pump_controller::Unpack_setpoints(etl::ivector<uint8_t> const &data, float scale){
+    auto entries = Packed_values::Unpack(std::span<const uint8_t>(data.data(), data.size()));
+    if (not entries.has_value()) {
+        return std::nullopt;
+    }
+
+    etl::vector<std::pair<uint8_t, float>, Packed_values::max_values> setpoints;
+    for (auto const &entry : entries.value()) {
+        setpoints.push_back({static_cast<uint8_t>(entry.channel + 1), Packed_values::Signed(entry.raw) * scale});
+    }
+    return setpoints;
+}
+
+bool Pump_controller::Valid_pump_indexes(std::span<const std::pair<uint8_t, float>> setpoints){
+    for (auto const &[pump_index, setpoint] : setpoints) {
+        if (not Valid_pump_index(pump_index)) {
+            Logger::Error("Pump batch invalid pump index: {}, batch not applied", pump_index);
+            return false;
+        }
+    }
+    return true;
+}
@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include <span>
+#include <utility>
+
 #include "can_bus/message_receiver.hpp"
 #include "component.hpp"
 #include "logger.hpp"
@@ -32,6 +35,7 @@
 #include "codes/messages/pumps/stop_all.hpp"
 #include "codes/messages/pumps/set_max_flowrate.hpp"
 #include "tools/motor_transfer_function.hpp"
+#include "tools/packed_values.hpp"
 #include "components/memory.hpp"
 
 class Pump: private DC_HBridge{
@@ -200,7 +204,7 @@ public:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(CAN::Message message) override final;
+    virtual bool Receive(CAN::Message const &message) override final;
 
     /**
      * @brief   Receive message implementation from Message_receiver interface for Application messages (extended frame)
@@ -210,9 +214,47 @@ public:
      * @return true     Message was processed by this component
      * @return false    Message cannot be processed by this component
      */
-    virtual bool Receive(Application_message message) override final;
+    virtual bool Receive(Application_message const &message) override final;
+
+    /**
+     * @brief   Set speed of multiple pumps at once
+     *          All indexes are validated first, speeds are then applied in single pass without yielding
+     *              so all pumps change together, nothing is applied when any index is invalid
+     *
+     * @param setpoints Pairs of pump index (1-based) and speed from -1.0 to 1.0
+     * @return true     All speeds were set
+     * @return false    No speed was set, some pump index is out of range
+     */
+    bool Set_speeds(std::span<const std::pair<uint8_t, float>> setpoints);
+
+    /**
+     * @brief   Set flowrate of multiple pumps at once, same rules as for Set_speeds applies
+     *
+     * @param setpoints Pairs of pump index (1-based) and flowrate in ml/min (negative value reverses direction)
+     * @return true     All flowrates were set
+     * @return false    No flowrate was set, some pump index is out of range
+     */
+    bool Set_flowrates(std::span<const std::pair<uint8_t, float>> setpoints);
 
 private:
+    /**
+     * @brief   Decode batch of setpoints from frame data, channel of packed value is converted to pump index
+     *
+     * @param data      Data of received batch frame
+     * @param scale     Scale of signed 12-bit value, resulting setpoint is raw * scale
+     * @return std::optional<etl::vector<std::pair<uint8_t, float>, Packed_values::max_values>>  Setpoints, empty when data are malformed
+     */
+    std::optional<etl::vector<std::pair<uint8_t, float>, Packed_values::max_values>> Unpack_setpoints(etl::ivector<uint8_t> const &data, float scale);
+
+    /**
+     * @brief   Check if all pump indexes of batch are valid
+     *
+     * @param setpoints Pairs of pump index (1-based) and setpoint
+     * @return true     All indexes are valid
+     * @return false    Some index is out of range
+     */
+    bool Valid_pump_indexes(std::span<const std::pair<uint8_t, float>> setpoints);
+
     /**
      * @brief   Check if pump index is valid
      *
@@ -138,7 +138,7 @@ void Spectrophotometer::Calibrate_channels(){
     }
 }
 
-bool Spectrophotometer::Receive(Application_message message){
+bool Spectrophotometer::Receive(Application_message const &message){
     switch (message.Message_type()) {
         case Codes::Message_type::Spectrophotometer_channel_count_request: {
             Logger::Notice("Spectrophotometer channel count request");
@@ -189,10 +189,11 @@ bool Spectrophotometer::Receive(Application_message message){
 
         case Codes::Message_type::Spectrophotometer_temperature_request: {
             Logger::Notice("Spectrophotometer temperature request");
-            App_messages::Spectrophotometer::Temperature_response response;
-            response.temperature = Temperature();
-            Send_CAN_message(response);
-            return true;
+            return Defer([this](){
+                App_messages::Spectrophotometer::Temperature_response response;
+                response.temperature = Temperature();
+                Send_CAN_message(response);
+            });
         }
 
         default:
@@ -200,7 +201,7 @@ bool Spectrophotometer::Receive(Application_message message){
     }
 }
 
-bool Spectrophotometer::Receive(CAN::Message message){
+bool Spectrophotometer::Receive(CAN::Message const &message){
     UNUSED(message);
     return true;
 }
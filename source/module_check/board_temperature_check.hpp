@@ -13,7 +13,7 @@ public:
             "Board_temperature_check",
             [module](const App_messages::Module_issue::Module_issue& issue) {
                 auto copy = issue;  
-                module->Send_CAN_message(copy);
+                module->Send_CAN_message(copy, CAN::TX_priority::Emergency);
             })
     {}
 };
@@ -13,7 +13,7 @@ public:
             "Bottle_bottom_sensor_temp_check",
             [bottle](const App_messages::Module_issue::Module_issue& issue) {
                 auto copy = issue;  
-                bottle->Send_CAN_message(copy);
+                bottle->Send_CAN_message(copy, CAN::TX_priority::Emergency);
             })
     {}
 };
\ No newline at end of file
@@ -13,7 +13,7 @@ public:
             "Core_load_check",
             [core](const App_messages::Module_issue::Module_issue& issue) {
                 auto copy = issue;  
-                core->Send_CAN_message(copy);
+                core->Send_CAN_message(copy, CAN::TX_priority::Emergency);
             })
     {}
 };
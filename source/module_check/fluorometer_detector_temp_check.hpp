@@ -13,7 +13,7 @@ public:
             "Fluorometer_detector_temp_check",
             [fluorometer](const App_messages::Module_issue::Module_issue& issue) {
                 auto copy = issue;  
-                fluorometer->Send_CAN_message(copy);
+                fluorometer->Send_CAN_message(copy, CAN::TX_priority::Emergency);
             })
     {}
 };
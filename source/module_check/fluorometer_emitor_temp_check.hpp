@@ -14,7 +14,7 @@ public:
             "Fluorometer_emitor_temp_check",
             [fluorometer](const App_messages::Module_issue::Module_issue& issue) {
                 auto copy = issue;
-                fluorometer->Send_CAN_message(copy);
+                fluorometer->Send_CAN_message(copy, CAN::TX_priority::Emergency);
             })
     {}
 };
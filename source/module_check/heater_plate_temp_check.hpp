@@ -13,7 +13,7 @@ public:
             "Heater_plate_temp_check",
             [heater](const App_messages::Module_issue::Module_issue& issue) {
                 auto copy = issue;
-                heater->Send_CAN_message(copy);
+                heater->Send_CAN_message(copy, CAN::TX_priority::Emergency);
             })
     {}
 };
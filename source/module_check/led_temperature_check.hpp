@@ -14,7 +14,7 @@ public:
             "Led_temperature_check",
             [panel](const App_messages::Module_issue::Module_issue& issue) {
                 auto copy = issue;
-                panel->Send_CAN_message(copy);
+                panel->Send_CAN_message(copy, CAN::TX_priority::Emergency);
             })
     {}
 };
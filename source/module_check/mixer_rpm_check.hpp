@@ -14,7 +14,7 @@ public:
             "Mixer_rpm_check",
             [rpm](const App_messages::Module_issue::Module_issue& issue) {
                 auto copy = issue;
-                rpm->Send_CAN_message(copy);
+                rpm->Send_CAN_message(copy, CAN::TX_priority::Emergency);
             })
     {}
 };
@@ -14,7 +14,7 @@ public:
             "Spectrophotometer_emitor_temp_check",
             [spectro](const App_messages::Module_issue::Module_issue& issue) {
                 auto copy = issue;
-                spectro->Send_CAN_message(copy);
+                spectro->Send_CAN_message(copy, CAN::TX_priority::Emergency);
             })
     {}
 };
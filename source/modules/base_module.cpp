@@ -30,6 +30,8 @@ Base_module::Base_module(Codes::Module module_type, Enumerator * const enumerato
 {
     this->singleton_instance = this;
 
+    CAN::Acceptance_filter::Module(module_type);
+
     #ifdef CONFIG_TEST_THREAD
         new Test_thread();
     #endif
@@ -60,22 +62,62 @@ Base_module * Base_module::Singleton_instance(){
     return singleton_instance;
 }
 
-uint Base_module::Send_CAN_message(App_messages::Base_message &message) {
+CAN_thread * Base_module::CAN_manager(){
     if (Singleton_instance()) {
-        return Singleton_instance()->can_thread->Send((message));
+        return Singleton_instance()->can_thread;
+    } else {
+        return nullptr;
+    }
+}
+
+Common_thread * Base_module::Dispatcher(){
+    if (Singleton_instance()) {
+        return Singleton_instance()->common_thread;
+    } else {
+        return nullptr;
+    }
+}
+
+uint Base_module::Send_CAN_message(App_messages::Base_message &message, CAN::TX_priority priority) {
+    if (Singleton_instance()) {
+        return Singleton_instance()->can_thread->Send(message, priority);
     } else {
         return 0;
     }
 }
 
-uint Base_module::Send_CAN_message(CAN::Message const &message) {
+uint Base_module::Send_CAN_message(CAN::Message const &message, CAN::TX_priority priority) {
     if (Singleton_instance()) {
-        return Singleton_instance()->can_thread->Send((message));
+        return Singleton_instance()->can_thread->Send(message, priority);
     } else {
         return 0;
     }
 }
 
+bool Base_module::Send_CAN_message_blocking(App_messages::Base_message &message, CAN::TX_priority priority, uint32_t timeout_ms) {
+    if (Singleton_instance()) {
+        return Singleton_instance()->can_thread->Send_blocking(message, priority, timeout_ms);
+    } else {
+        return false;
+    }
+}
+
+bool Base_module::Send_CAN_message_blocking(CAN::Message const &message, CAN::TX_priority priority, uint32_t timeout_ms) {
+    if (Singleton_instance()) {
+        return Singleton_instance()->can_thread->Send_blocking(message, priority, timeout_ms);
+    } else {
+        return false;
+    }
+}
+
+bool Base_module::Flush_CAN_messages(uint32_t timeout_ms) {
+    if (Singleton_instance()) {
+        return Singleton_instance()->can_thread->Flush(timeout_ms);
+    } else {
+        return false;
+    }
+}
+
 std::optional<float> Base_module::Version_voltage() const{
     bool lock = adc_mutex->Lock(0);
     if (!lock) {
@@ -155,18 +155,52 @@ public:
     /**
      * @brief Wrapper function to send message to CAN bus via can_thread
      *
-     * @param message  Message to be sent
-     * @return uint    Number of messages in queue, if 0 then was send immediately
+     * @param message   Message to be sent
+     * @param priority  Priority class of message
+     * @return uint     Number of messages in queue, if 0 then was send immediately
      */
-    static uint Send_CAN_message(App_messages::Base_message &message);
+    static uint Send_CAN_message(App_messages::Base_message &message, CAN::TX_priority priority = CAN::TX_priority::Normal);
 
     /**
      * @brief Wrapper function to send message to CAN bus via can_thread
      *
-     * @param message  Message to be sent
-     * @return uint    Number of messages in queue, if 0 then was send immediately
+     * @param message   Message to be sent
+     * @param priority  Priority class of message
+     * @return uint     Number of messages in queue, if 0 then was send immediately
      */
-    static uint Send_CAN_message(CAN::Message const &message);
+    static uint Send_CAN_message(CAN::Message const &message, CAN::TX_priority priority = CAN::TX_priority::Normal);
+
+    /**
+     * @brief   Wrapper function to send message to CAN bus via can_thread, caller is blocked while tx queue is full
+     *          Intended for bulk producers which need to saturate bus without losing messages
+     *
+     * @param message       Message to be sent
+     * @param priority      Priority class of message
+     * @param timeout_ms    Maximal time to wait for free space in tx queue
+     * @return true         Message was transmitted or queued
+     * @return false        Timeout elapsed or CAN thread is not available
+     */
+    static bool Send_CAN_message_blocking(App_messages::Base_message &message, CAN::TX_priority priority, uint32_t timeout_ms);
+
+    /**
+     * @brief   Wrapper function to send message to CAN bus via can_thread, caller is blocked while tx queue is full
+     *
+     * @param message       Message to be sent
+     * @param priority      Priority class of message
+     * @param timeout_ms    Maximal time to wait for free space in tx queue
+     * @return true         Message was transmitted or queued
+     * @return false        Timeout elapsed or CAN thread is not available
+     */
+    static bool Send_CAN_message_blocking(CAN::Message const &message, CAN::TX_priority priority, uint32_t timeout_ms);
+
+    /**
+     * @brief   Wait until all messages queued in can_thread are passed to CAN peripheral
+     *
+     * @param timeout_ms    Maximal time to wait
+     * @return true         All messages were passed to peripheral
+     * @return false        Timeout elapsed or CAN thread is not available
+     */
+    static bool Flush_CAN_messages(uint32_t timeout_ms);
 
     /**
      * @brief   Retrieves current temperature of board
@@ -188,4 +222,18 @@ public:
      */
     static Base_module * Singleton_instance();
 
+    /**
+     * @brief   Thread dispatching received messages to components, used for diagnostics
+     *
+     * @return Common_thread*   Dispatcher thread, nullptr if module is not initialized
+     */
+    static Common_thread * Dispatcher();
+
+    /**
+     * @brief   Thread managing CAN bus peripheral, used for diagnostics
+     *
+     * @return CAN_thread*  CAN thread, nullptr if module is not initialized
+     */
+    static CAN_thread * CAN_manager();
+
 };
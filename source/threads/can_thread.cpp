@@ -1,42 +1,67 @@
 #include "can_thread.hpp"
-#include "can_bus/can_bus.hpp"
+#include "can_bus/bus_backend.hpp"
 #include "logger.hpp"
 #include "config.hpp"
 
+#include <algorithm>
+#include "pico/time.h"
+
+#ifndef CONFIG_CAN_TX_NORMAL_SHARE
+    #define CONFIG_CAN_TX_NORMAL_SHARE 0
+#endif
+
+#ifndef CONFIG_CAN_TX_BULK_SHARE
+    #define CONFIG_CAN_TX_BULK_SHARE 0
+#endif
+
 CAN_thread::CAN_thread()
-    : Thread("can_thread", 2048, 10)
+    : Thread("can_thread", 2048, 10),
+    tx_progress(xEventGroupCreate())
 {
     Logger::Debug("CAN thread created");
+    Bus_share(CAN::TX_priority::Normal, CONFIG_CAN_TX_NORMAL_SHARE / 100.0f);
+    Bus_share(CAN::TX_priority::Bulk, CONFIG_CAN_TX_BULK_SHARE / 100.0f);
     Start();
 };
 
 void CAN_thread::Run(){
     Logger::Debug("CAN thread start");
 
+#if defined(CONFIG_CAN_BACKEND_LOOPBACK)
+    can_bus = new CAN::Virtual_bus();
+#else
     can_bus = new CAN::Bus(5, 4, CONFIG_CANBUS_SPEED, 1);
+#endif
+
+    if (dispatcher != nullptr) {
+        can_bus->Notify_on_receive(dispatcher);
+    }
+
+    utilization_sampler = new rtos::Repeated_execution([this](){ Sample_utilization(); }, utilization_period_ms, true);
+
+    shaper_wakeup = new rtos::Delayed_execution([this](){
+        if (Pending_messages() and can_bus->Transmit_available()) {
+            Retransmit();
+        }
+        xEventGroupSetBits(tx_progress, tx_progress_bit);
+    });
 
     Logger::Debug("CAN thread running");
 
     while (true) {
         // Wait for any IRQ from CAN bus peripheral
-        CAN::Bus::IRQ_type irq_type = can_bus->Wait_for_any<CAN::Bus::IRQ_type>();
+        CAN::Bus_backend::IRQ_type irq_type = can_bus->Wait_for_any<CAN::Bus_backend::IRQ_type>();
 
-        if(irq_type == CAN::Bus::IRQ_type::TX){ // Message was transmitted
-            if (not tx_queue.empty()) {
+        if(irq_type == CAN::Bus_backend::IRQ_type::TX){ // Message was transmitted
+            if (Pending_messages()) {
                 Retransmit();
             }
-        } else if(irq_type == CAN::Bus::IRQ_type::RX){  // Message was received
-            while(can_bus->Received_queue_size() > 0){
-                auto message_data = can_bus->Receive();
-                if (not message_data.has_value()) {
-                    Logger::Error("CAN message not found after RX IRQ");
-                } else {
-                    // Convert message from can2040 struct to CAN::Message
-                    CAN::Message message = CAN::Message(&message_data.value());
-                    Receive(message);
-                }
-            }
-        } else if (irq_type == CAN::Bus::IRQ_type::Error){  // Error occurred
+            // Wake senders waiting for space in queue or for completion of transmission
+            xEventGroupSetBits(tx_progress, tx_progress_bit);
+        } else if(irq_type == CAN::Bus_backend::IRQ_type::RX){  // Message was received
+            // Messages are decoded into receive ring directly in ISR and read from there by dispatcher
+            Logger::Trace("CAN message received, waiting: {}", (short)can_bus->Received_queue_size());
+        } else if (irq_type == CAN::Bus_backend::IRQ_type::Error){  // Error occurred
             Logger::Error("CAN Error IRQ");
         } else {
             Logger::Error("CAN Unknown IRQ");   // Incorrect IRQ type evaluated
@@ -44,81 +69,249 @@ void CAN_thread::Run(){
     }
 };
 
-uint CAN_thread::Send(CAN::Message const &message){
-    if(tx_queue.empty()){
-        if(can_bus->Transmit_available()){
+uint CAN_thread::Send(CAN::Message const &message, CAN::TX_priority priority){
+    if (Application_message::Emergency(message)) {
+        priority = CAN::TX_priority::Emergency;
+    }
+
+    TX_queue &tx_queue = *tx_queues[static_cast<uint8_t>(priority)];
+
+    // Lower priority messages can be waiting, message is sent immediately if it is first in its class and class is within its bus share
+    if ((not Pending_messages(priority)) and can_bus->Transmit_available()) {
+        if (not Shaping_allows(message, priority)) {
+            // Counted only here, retransmission checks the same frame repeatedly until tokens are available
+            tx_statistics.throttled[static_cast<uint8_t>(priority)]++;
+        } else {
             Logger::Trace("CAN bus available");
             if (can_bus->Transmit(message)){
                 Logger::Trace("CAN message transmitted");
+                Charge_shaping(message, priority);
+                tx_statistics.immediate++;
+                return 0;
             } else {
                 Logger::Warning("CAN message not transmitted");
             }
-        } else {
-            Logger::Debug("CAN not available, message queued, size: {}, available {}", tx_queue.size(), tx_queue.available());
-            tx_queue.push(message);
-        }
-    } else {
-        Logger::Debug("CAN queue not empty, message queued, size: {}, available {}", tx_queue.size(), tx_queue.available());
-        if (tx_queue.full()) {
-            Logger::Warning("CAN TX queue full, message dropped");
-            return 0;
-        } else {
-            tx_queue.push(message);
-            if (tx_queue.size() % 8 == 0) {
-                static uint8_t emergency_retransmit_count = 0;
-                emergency_retransmit_count++;
-                Logger::Warning("CAN Emergency retransmit count: {}", (short)emergency_retransmit_count);
-                Logger::Warning("CAN performing retransmit attempt");
-                Retransmit();
-            }
         }
     }
-    return tx_queue.available();
+
+    if (tx_queue.full()) {
+        Logger::Warning("CAN TX queue full, message dropped");
+        tx_statistics.dropped[static_cast<uint8_t>(priority)]++;
+        return tx_queue.size();
+    }
+
+    tx_queue.push(message);
+    uint32_t &high_water = tx_statistics.high_water[static_cast<uint8_t>(priority)];
+    high_water = std::max<uint32_t>(high_water, tx_queue.size());
+    Logger::Debug("CAN message queued, priority: {}, size: {}, available {}", (short)priority, tx_queue.size(), tx_queue.available());
+
+    // Peripheral could free slots since last TX IRQ, refill them from highest class
+    if (can_bus->Transmit_available()) {
+        Retransmit();
+    }
+    return tx_queue.size();
 };
 
-uint CAN_thread::Send(App_messages::Base_message &message){
+uint CAN_thread::Send(App_messages::Base_message &message, CAN::TX_priority priority){
     Application_message app_message(message);
-    return Send(app_message);
+    if (priority == CAN::TX_priority::Emergency) {
+        app_message.Emergency(true);
+    }
+    return Send(app_message, priority);
 }
 
-void CAN_thread::Receive(CAN::Message const &message){
-    if(rx_queue.full()){
-        Logger::Warning("CAN RX queue full, message dropped");
-        return;
+bool CAN_thread::Try_send(CAN::Message const &message, CAN::TX_priority priority){
+    if (Application_message::Emergency(message)) {
+        priority = CAN::TX_priority::Emergency;
     }
-    rx_queue.push(message);
-    Logger::Trace("CAN message received, queue size: {}, available: {}", rx_queue.size(), rx_queue.available());
-};
+
+    if (tx_queues[static_cast<uint8_t>(priority)]->full()) {
+        return false;
+    }
+
+    Send(message, priority);
+    return true;
+}
+
+bool CAN_thread::Send_blocking(CAN::Message const &message, CAN::TX_priority priority, uint32_t timeout_ms){
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = fra::Ticks::MsToTicks(timeout_ms);
+
+    while (not Try_send(message, priority)) {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= timeout) {
+            Logger::Warning("CAN blocking send timeout");
+            return false;
+        }
+        xEventGroupWaitBits(tx_progress, tx_progress_bit, pdTRUE, pdFALSE, timeout - elapsed);
+    }
+    return true;
+}
+
+bool CAN_thread::Send_blocking(App_messages::Base_message &message, CAN::TX_priority priority, uint32_t timeout_ms){
+    Application_message app_message(message);
+    if (priority == CAN::TX_priority::Emergency) {
+        app_message.Emergency(true);
+    }
+    return Send_blocking(app_message, priority, timeout_ms);
+}
+
+bool CAN_thread::Flush(uint32_t timeout_ms){
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = fra::Ticks::MsToTicks(timeout_ms);
+
+    while (Pending_messages()) {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= timeout) {
+            return false;
+        }
+        xEventGroupWaitBits(tx_progress, tx_progress_bit, pdTRUE, pdFALSE, timeout - elapsed);
+    }
+    return true;
+}
+
+bool CAN_thread::Pending_messages(CAN::TX_priority priority) const{
+    for (uint8_t index = 0; index <= static_cast<uint8_t>(priority); index++) {
+        if (not tx_queues[index]->empty()) {
+            return true;
+        }
+    }
+    return false;
+}
 
 uint8_t CAN_thread::Retransmit(){
     uint8_t retransmitted = 0;
-    while((can_bus->Transmit_available()) and (not tx_queue.empty())){
-        CAN::Message message = tx_queue.front();
-        uint ret = can_bus->Transmit(message);
+    uint32_t shaper_wait_us = UINT32_MAX;
+
+    while(can_bus->Transmit_available()){
+        // Find highest priority class with waiting message which is within its bus share
+        TX_queue * queue = nullptr;
+        uint8_t queue_index = 0;
+        for (uint8_t index = 0; index < tx_queues.size(); index++) {
+            if (tx_queues[index]->empty()) {
+                continue;
+            }
+            auto priority = static_cast<CAN::TX_priority>(index);
+            CAN::Message const &message = tx_queues[index]->front();
+            if (Shaping_allows(message, priority)) {
+                queue = tx_queues[index];
+                queue_index = index;
+                break;
+            }
+            uint32_t bits = CAN::Bus_statistics::Frame_bits(message.data.size(), message.Extended());
+            shaper_wait_us = std::min(shaper_wait_us, tx_buckets[index].Time_to_available(bits, time_us_32()));
+        }
+        if (queue == nullptr) {
+            break;
+        }
+
+        uint ret = can_bus->Transmit(queue->front());
         if (not ret) {
             Logger::Error("Transmission failed");
             break;
         }
-        tx_queue.pop();
+        Charge_shaping(queue->front(), static_cast<CAN::TX_priority>(queue_index));
+        queue->pop();
         retransmitted++;
     }
+
+    // Throttled messages would wait for TX IRQ of other message, which may never come
+    if (shaper_wait_us != UINT32_MAX) {
+        Schedule_shaper(shaper_wait_us);
+    }
+
+    tx_statistics.retransmits += retransmitted;
     Logger::Trace("CAN retransmitted: {}", (short)retransmitted);
     return retransmitted;
 };
 
+bool CAN_thread::Shaping_allows(CAN::Message const &message, CAN::TX_priority priority){
+    uint8_t index = static_cast<uint8_t>(priority);
+    uint32_t bits = CAN::Bus_statistics::Frame_bits(message.data.size(), message.Extended());
+    return tx_buckets[index].Time_to_available(bits, time_us_32()) == 0;
+}
+
+void CAN_thread::Charge_shaping(CAN::Message const &message, CAN::TX_priority priority){
+    uint8_t index = static_cast<uint8_t>(priority);
+    uint32_t bits = CAN::Bus_statistics::Frame_bits(message.data.size(), message.Extended());
+    // Availability was checked before transmission and bucket only gains tokens since, so tokens are always taken
+    tx_buckets[index].Consume(bits, time_us_32());
+}
+
+void CAN_thread::Schedule_shaper(uint32_t wait_us){
+    if (shaper_wakeup == nullptr) {
+        return;
+    }
+    shaper_wakeup->Execute(std::max<uint32_t>(1, (wait_us + 999) / 1000));
+}
+
+void CAN_thread::Bus_share(CAN::TX_priority priority, float share){
+    if (priority == CAN::TX_priority::Emergency) {
+        Logger::Warning("Emergency messages cannot be limited");
+        return;
+    }
+
+    share = std::clamp(share, 0.0f, 1.0f);
+    uint32_t rate_bps = static_cast<uint32_t>(CONFIG_CANBUS_SPEED * share);
+    uint32_t burst_bits = burst_frames * CAN::Bus_statistics::Frame_bits(8, true);
+    tx_buckets[static_cast<uint8_t>(priority)] = CAN::Token_bucket(rate_bps, burst_bits, time_us_32());
+    Logger::Debug("CAN bus share of class {}: {} bps", (short)priority, rate_bps);
+}
+
 uint32_t CAN_thread::Received_messages(){
-    return rx_queue.size();
+    if (can_bus == nullptr) {
+        return 0;
+    }
+    return can_bus->Received_queue_size();
 };
 
 bool CAN_thread::Message_available() const{
-    return not rx_queue.empty();
+    return Read_message() != nullptr;
 };
 
-std::optional<CAN::Message> CAN_thread::Read_message(){
-    if (rx_queue.empty()) {
+Application_message const * CAN_thread::Read_message() const{
+    if (can_bus == nullptr) {
+        return nullptr;
+    }
+    return can_bus->Receive();
+};
+
+void CAN_thread::Release_message(){
+    can_bus->Release();
+};
+
+void CAN_thread::Sample_utilization(){
+    if (can_bus == nullptr) {
+        return;
+    }
+    uint32_t bus_bits = can_bus->Stats().bus_bits;
+    bus_utilization = static_cast<float>(bus_bits - last_bus_bits) / (static_cast<float>(CONFIG_CANBUS_SPEED) * utilization_period_ms / 1000.0f);
+    last_bus_bits = bus_bits;
+}
+
+CAN::Bus_statistics CAN_thread::Bus_statistics() const{
+    if (can_bus == nullptr) {
         return {};
     }
-    CAN::Message message = rx_queue.front();
-    rx_queue.pop();
-    return message;
+    return can_bus->Stats();
+}
+
+void CAN_thread::Timestamp_transmit(CAN::Message const &message){
+    if (can_bus != nullptr) {
+        can_bus->Timestamp_transmit(message);
+    }
+}
+
+std::optional<uint32_t> CAN_thread::Transmit_timestamp() const{
+    if (can_bus == nullptr) {
+        return std::nullopt;
+    }
+    return can_bus->Transmit_timestamp();
+}
+
+void CAN_thread::Attach_dispatcher(TaskHandle_t task){
+    dispatcher = task;
+    if (can_bus != nullptr) {
+        can_bus->Notify_on_receive(dispatcher);
+    }
 };
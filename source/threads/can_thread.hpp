@@ -7,14 +7,21 @@
 
 #pragma once
 
+#include <optional>
 
 #include "thread.hpp"
 #include "ticks.hpp"
 #include "rtos/wrappers.hpp"
+#include "rtos/repeated_execution.hpp"
+#include "rtos/delayed_execution.hpp"
 
-#include "can_bus/can_bus.hpp"
+#include "FreeRTOS.h"
+#include "event_groups.h"
+
+#include "can_bus/bus_backend.hpp"
 #include "can_bus/can_message.hpp"
 #include "can_bus/app_message.hpp"
+#include "can_bus/token_bucket.hpp"
 
 #ifndef CAN_DATA_TYPE
     #define CAN_DATA_TYPE etl::vector<uint8_t, 8>
@@ -25,6 +32,7 @@
 #include "logger.hpp"
 
 #include "etl/queue.h"
+#include "etl/array.h"
 
 namespace fra = cpp_freertos;
 
@@ -39,27 +47,101 @@ public:
      */
     explicit CAN_thread();
 
+    /**
+     * @brief   Counters of outgoing messages per priority class (index is CAN::TX_priority)
+     */
+    struct TX_statistics {
+        uint32_t immediate      = 0;            // Messages transmitted without queuing
+        uint32_t retransmits    = 0;            // Messages transmitted from tx queues after TX IRQ
+        etl::array<uint32_t, 3> dropped     = {};   // Messages dropped due to full queue
+        etl::array<uint32_t, 3> high_water  = {};   // Maximal number of messages waiting in queue
+        etl::array<uint32_t, 3> throttled   = {};   // Messages queued because token bucket of class was empty, each counted once
+    };
+
 private:
     /**
-     * @brief CAN bus peripheral based on can2040 library
+     * @brief CAN bus peripheral, can2040 library or virtual bus based on configuration
+     */
+    CAN::Bus_backend * can_bus = nullptr;
+
+    /**
+     * @brief   Task processing received messages, notified directly by CAN bus peripheral when message is received
      */
-    CAN::Bus * can_bus;
+    TaskHandle_t dispatcher = nullptr;
 
     /**
-     * @brief   Size of queue for incoming and outgoing messages
-     *          Messages which overflow this size are dropped
+     * @brief   Type of queue for outgoing messages independent of queue size
      */
-    static const uint32_t queue_size = 64;
+    using TX_queue = etl::iqueue<CAN::Message, etl::memory_model::MEMORY_MODEL_SMALL>;
 
     /**
-     * @brief  Queue for outgoing messages
+     * @brief  Queue for outgoing messages with emergency flag (alarms, module issues)
      */
-    etl::queue<CAN::Message, queue_size, etl::memory_model::MEMORY_MODEL_SMALL> tx_queue;
+    etl::queue<CAN::Message, 8, etl::memory_model::MEMORY_MODEL_SMALL> emergency_queue;
 
     /**
-     * @brief  Queue for incoming messages
+     * @brief  Queue for regular outgoing messages (responses, control)
      */
-    etl::queue<CAN::Message, queue_size, etl::memory_model::MEMORY_MODEL_SMALL> rx_queue;
+    etl::queue<CAN::Message, 32, etl::memory_model::MEMORY_MODEL_SMALL> normal_queue;
+
+    /**
+     * @brief  Queue for outgoing bulk data (measurement exports)
+     *         Messages which overflow size of queue are dropped
+     */
+    etl::queue<CAN::Message, 64, etl::memory_model::MEMORY_MODEL_SMALL> bulk_queue;
+
+    /**
+     * @brief  Queues for outgoing messages ordered by priority class (index is CAN::TX_priority)
+     */
+    const etl::array<TX_queue *, 3> tx_queues = {&emergency_queue, &normal_queue, &bulk_queue};
+
+    /**
+     * @brief   Bit of tx_progress set after every TX IRQ when peripheral buffer was refilled from tx queues
+     *          Used by blocking senders to wait for free space in queue or for transmission of all messages
+     *          Event group wakes all waiting senders at once, each of them then checks its own condition
+     */
+    static constexpr EventBits_t tx_progress_bit = 1 << 0;
+    EventGroupHandle_t tx_progress;
+
+    /**
+     * @brief   Counters of outgoing messages
+     */
+    TX_statistics tx_statistics;
+
+    /**
+     * @brief   Limits of bus share of priority classes (index is CAN::TX_priority), emergency class is never limited
+     */
+    etl::array<CAN::Token_bucket, 3> tx_buckets;
+
+    /**
+     * @brief   Burst size of limited classes in frames of maximal length, allows short bursts of responses without delay
+     */
+    static constexpr uint32_t burst_frames = 16;
+
+    /**
+     * @brief   Retransmits queued messages when token bucket of throttled class is refilled and no TX IRQ would wake CAN thread
+     */
+    rtos::Delayed_execution * shaper_wakeup = nullptr;
+
+    /**
+     * @brief   Periodically evaluates bus utilization from number of bits observed on bus
+     */
+    rtos::Repeated_execution * utilization_sampler = nullptr;
+
+    /**
+     * @brief   Period of bus utilization evaluation
+     */
+    static constexpr uint32_t utilization_period_ms = 1000;
+
+    /**
+     * @brief   Number of bits observed on bus at last evaluation of utilization
+     */
+    uint32_t last_bus_bits = 0;
+
+    /**
+     * @brief   Estimated utilization of bus during last period (0.0 - 1.0), bit stuffing is not included
+     */
+    float bus_utilization = 0.0f;
 
 protected:
     /**
@@ -69,18 +151,47 @@ protected:
 
 private:
     /**
-     * @brief Executed when message if received stores it into rx queue
+     * @brief   Executed when message is transmitted, free slots of peripheral buffer are refilled from tx queues
+     *          Messages are always taken from highest priority class which is not empty
      *
-     * @param message   Received message
+     * @return uint8_t  Number of messages removed from tx queues
      */
-    void Receive(CAN::Message const &message);
+    uint8_t Retransmit();
 
     /**
-     * @brief Executed when message is transmitted, if there is any message in tx queue, it is transmitted (put into peripheral buffer)
+     * @brief   Check if any of tx queues with same or higher priority than given class contains message
      *
-     * @return uint8_t  Number of messages removed from tx queue
+     * @param priority  Lowest priority class which is checked
+     * @return true     There is pending message
+     * @return false    All checked queues are empty
      */
-    uint8_t Retransmit();
+    bool Pending_messages(CAN::TX_priority priority = CAN::TX_priority::Bulk) const;
+
+    /**
+     * @brief   Check if bucket of priority class contains tokens for transmission of message, tokens are not taken
+     *
+     * @param message   Message to be transmitted
+     * @param priority  Priority class of message
+     * @return true     Message can be transmitted now
+     * @return false    Class exceeded its bus share, message must wait in queue
+     */
+    bool Shaping_allows(CAN::Message const &message, CAN::TX_priority priority);
+
+    /**
+     * @brief   Take tokens for message from bucket of its priority class, called only after message was accepted by peripheral
+     *          so failed transmission does not charge the class and retried frame is charged once
+     *
+     * @param message   Transmitted message
+     * @param priority  Priority class of message
+     */
+    void Charge_shaping(CAN::Message const &message, CAN::TX_priority priority);
+
+    /**
+     * @brief   Schedule retransmission of queued messages after tokens of throttled class are refilled
+     *
+     * @param wait_us   Time until tokens are available in microseconds
+     */
+    void Schedule_shaper(uint32_t wait_us);
 
     /**
      * @brief   Menage error when happens, maybe
@@ -93,42 +204,151 @@ private:
      */
     bool Error_management(CAN::Message const &message);
 
+    /**
+     * @brief   Evaluate bus utilization from bits observed on bus since last evaluation
+     */
+    void Sample_utilization();
+
 public:
     /**
-     * @brief If peripheral is available for transmitting new message, it is sent, otherwise message is queued
+     * @brief   If peripheral is available for transmitting new message, it is sent, otherwise message is queued
+     *          Messages with emergency flag are always placed into emergency class
      *
      * @param message   Message to be sent
-     * @return uint     Number of messages in queue, if 0 then was send immediately
+     * @param priority  Priority class of message
+     * @return uint     Number of messages in queue of priority class, if 0 then was send immediately
      */
-    uint Send(CAN::Message const &message);
+    uint Send(CAN::Message const &message, CAN::TX_priority priority = CAN::TX_priority::Normal);
 
     /**
-     * @brief If peripheral is available for transmitting new message, it is sent, otherwise message is queued
+     * @brief   If peripheral is available for transmitting new message, it is sent, otherwise message is queued
+     *          Emergency flag of message is set when emergency priority is requested
      *
      * @param message   Message to be sent
-     * @return uint     Number of messages in queue, if 0 then was send immediately
+     * @param priority  Priority class of message
+     * @return uint     Number of messages in queue of priority class, if 0 then was send immediately
+     */
+    uint Send(App_messages::Base_message &message, CAN::TX_priority priority = CAN::TX_priority::Normal);
+
+    /**
+     * @brief   Send message without blocking, message is not dropped silently when queue of priority class is full
+     *
+     * @param message   Message to be sent
+     * @param priority  Priority class of message
+     * @return true     Message was transmitted or queued
+     * @return false    Queue of priority class is full, message was not accepted
+     */
+    bool Try_send(CAN::Message const &message, CAN::TX_priority priority = CAN::TX_priority::Normal);
+
+    /**
+     * @brief   Send message, if queue of priority class is full, caller is blocked until space is released by TX IRQ
+     *          Must not be called from CAN thread itself
+     *
+     * @param message       Message to be sent
+     * @param priority      Priority class of message
+     * @param timeout_ms    Maximal time to wait for free space in queue
+     * @return true         Message was transmitted or queued
+     * @return false        Timeout elapsed, message was not accepted
      */
-    uint Send(App_messages::Base_message &message);
+    bool Send_blocking(CAN::Message const &message, CAN::TX_priority priority, uint32_t timeout_ms);
 
     /**
-     * @brief   Number of received messages in rx queue
+     * @brief   Convert message to application message and send it, caller is blocked while queue of priority class is full
      *
-     * @return uint32_t Number of messages in rx queue
+     * @param message       Message to be sent
+     * @param priority      Priority class of message
+     * @param timeout_ms    Maximal time to wait for free space in queue
+     * @return true         Message was transmitted or queued
+     * @return false        Timeout elapsed, message was not accepted
+     */
+    bool Send_blocking(App_messages::Base_message &message, CAN::TX_priority priority, uint32_t timeout_ms);
+
+    /**
+     * @brief   Block caller until all queued messages are passed to peripheral, progress is signalled by TX IRQ
+     *          Must not be called from CAN thread itself
+     *
+     * @param timeout_ms    Maximal time to wait
+     * @return true         All tx queues are empty
+     * @return false        Timeout elapsed before all messages were transmitted
+     */
+    bool Flush(uint32_t timeout_ms);
+
+    /**
+     * @brief   Limit share of bus bandwidth used by priority class, initial limits are given by configuration
+     *          Messages over limit are not dropped, but wait in queue of class until bucket is refilled
+     *
+     * @param priority      Priority class, emergency class cannot be limited
+     * @param share         Share of bus bandwidth (0.0 - 1.0), 0 disables limit
+     */
+    void Bus_share(CAN::TX_priority priority, float share);
+
+    /**
+     * @brief   Number of received messages waiting in receive ring of CAN bus peripheral
+     *
+     * @return uint32_t Number of messages waiting for processing
      */
     uint32_t Received_messages();
 
     /**
-     * @brief   Check if there is any message in rx queue
+     * @brief   Check if there is any received message waiting for processing
      *
-     * @return true     There is message in rx queue
-     * @return false    There is no message in rx queue
+     * @return true     There is message waiting
+     * @return false    There is no message waiting
      */
     bool Message_available() const;
 
     /**
-     * @brief   Read message from rx queue, message is removed from queue
+     * @brief   Oldest received message, message is read in place from receive ring of CAN bus peripheral
+     *          Message stays valid until Release_message is called
+     *
+     * @return Application_message const*   Received message, nullptr if no message is waiting
+     */
+    Application_message const * Read_message() const;
+
+    /**
+     * @brief   Release oldest received message (obtained by Read_message), slot is returned to receive ring
+     */
+    void Release_message();
+
+    /**
+     * @brief   Set task which processes received messages, task is notified (task notification) immediately when message is received
+     *
+     * @param task  Handle of dispatcher task
+     */
+    void Attach_dispatcher(TaskHandle_t task);
+
+    /**
+     * @brief   Counters of CAN bus peripheral (received, transmitted, dropped frames, errors)
+     *
+     * @return CAN::Bus_statistics  Copy of counters, empty if peripheral is not initialized yet
+     */
+    CAN::Bus_statistics Bus_statistics() const;
+
+    /**
+     * @brief   Capture time of transmission of next frame with same identifier as message
+     *
+     * @param message   Message which time of transmission should be captured
+     */
+    void Timestamp_transmit(CAN::Message const &message);
+
+    /**
+     * @brief   Time of transmission of frame armed by Timestamp_transmit
+     *
+     * @return std::optional<uint32_t>  Lower 32 bits of system timer in us, empty if frame was not transmitted yet
+     */
+    std::optional<uint32_t> Transmit_timestamp() const;
+
+    /**
+     * @brief   Counters of outgoing messages (drops and high-water marks of tx queues)
+     *
+     * @return TX_statistics const&     Counters of tx queues
+     */
+    TX_statistics const & TX_stats() const { return tx_statistics; };
+
+    /**
+     * @brief   Estimated utilization of bus during last second
      *
-     * @return std::optional<CAN::Message>   Received message if any was in queue, otherwise empty optional
+     * @return float    Utilization in range 0.0 - 1.0
      */
-    std::optional<CAN::Message> Read_message();
+    float Bus_utilization() const { return bus_utilization; };
 };
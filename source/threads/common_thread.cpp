@@ -1,6 +1,9 @@
 #include "common_thread.hpp"
 #include "modules/base_module.hpp"
 
+#include <algorithm>
+#include "pico/time.h"
+
 Common_thread::Common_thread(CAN_thread * can_thread, EEPROM_storage * const memory):
     Thread("common_thread", 2048, 9),
     can_thread(can_thread),
@@ -8,6 +11,7 @@ Common_thread::Common_thread(CAN_thread * can_thread, EEPROM_storage * const mem
 {
     Logger::Debug("Common thread created");
     Start();
+    can_thread->Attach_dispatcher(GetHandle());
 }
 
 void Common_thread::Run(){
@@ -21,14 +25,34 @@ void Common_thread::Run(){
         Logger::Debug("Memory type check passed");
     }
 
+    // Messages received before dispatcher was attached to CAN bus are processed in first iteration
+    xTaskNotifyGive(GetHandle());
+
     while (true) {
-        DelayUntil(fra::Ticks::MsToTicks(1));
+        // Push due telemetry and time out pending requests, sleep until next deadline or until notification from CAN bus peripheral
+        TickType_t wait = std::min(Telemetry_service::Service(), Request_tracker::Service());
+
+        // All pending notifications are cleared at once
+        if (ulTaskNotifyTake(pdTRUE, wait) == 0) {
+            continue;
+        }
+        statistics.wakeups++;
+
+        bool dispatched = false;
+        while(auto message_in = can_thread->Read_message()) {
+            uint32_t latency = time_us_32() - message_in->Receive_time();
+            statistics.latency_min_us = std::min(statistics.latency_min_us, latency);
+            statistics.latency_max_us = std::max(statistics.latency_max_us, latency);
+            statistics.latency_sum_us += latency;
+            statistics.dispatched++;
+
+            Message_router::Route(*message_in);
+            can_thread->Release_message();
+            dispatched = true;
+        }
 
-        while(can_thread->Message_available()) {
-            auto message_in = can_thread->Read_message();
-            if (message_in.has_value()) {
-                Message_router::Route(message_in.value());
-            }
+        if (not dispatched) {
+            statistics.idle_wakeups++;
         }
     }
 }
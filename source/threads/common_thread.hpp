@@ -12,6 +12,8 @@
 #include "components/memory.hpp"
 #include "logger.hpp"
 #include "can_bus/message_router.hpp"
+#include "can_bus/telemetry_service.hpp"
+#include "can_bus/request_tracker.hpp"
 
 #include "thread.hpp"
 
@@ -20,9 +22,23 @@ namespace fra = cpp_freertos;
 /**
  * @brief  This thread is present in all modules and is mainly responsible for handling of received messages via Message_router¨
  *             Does not spawn new thead for task processing, but perform them directly
+ *             Handlers which wait for hardware defer their work to Job_executor, so dispatch latency stays bounded
  *             Task which are more complex or takes longer time should spawn new thread itself
  */
 class Common_thread : public fra::Thread {
+public:
+    /**
+     * @brief   Statistics of message dispatching, used to evaluate latency of message processing
+     */
+    struct Dispatch_statistics {
+        uint32_t wakeups            = 0;
+        uint32_t idle_wakeups       = 0;
+        uint32_t dispatched         = 0;
+        uint32_t latency_min_us     = UINT32_MAX;
+        uint32_t latency_max_us     = 0;
+        uint64_t latency_sum_us     = 0;
+    };
+
 private:
     /**
      * @brief   Pointer to CAN bus manager thread which is responsible for handling of CAN Bus peripheral
@@ -35,6 +51,11 @@ private:
      */
     EEPROM_storage * const memory;
 
+    /**
+     * @brief   Statistics of message dispatching
+     */
+    Dispatch_statistics statistics;
+
 public:
     /**
      * @brief Construct a new Common_thread object
@@ -43,9 +64,20 @@ public:
      */
     Common_thread(CAN_thread * can_threadm, EEPROM_storage * const memory);
 
+    /**
+     * @brief   Statistics of message dispatching
+     *          Idle wakeups are wakeups without any message to process
+     *          Latency is measured from reception of message in ISR to start of its routing
+     *
+     * @return Dispatch_statistics const&   Dispatch counters and latency
+     */
+    Dispatch_statistics const & Statistics() const { return statistics; };
+
 protected:
     /**
      * @brief   Main function of thread, executed after thread starts
+     *          Thread sleeps until CAN bus peripheral notifies it about received message, until next telemetry subscription is due
+     *              or until pending request times out
      */
     virtual void Run();
 };
@@ -4,12 +4,15 @@ Fluorometer_thread::Fluorometer_thread(Fluorometer * const fluorometer):
     Thread("fluorometer_thread", 2048, 7),
     fluorometer(fluorometer){
     Start();
+    mailbox.Attach(GetHandle());
 }
 
 void Fluorometer_thread::Run(){
     Logger::Trace("Fluorometer thread start");
 
     while (true) {
+        // Sleep until message is posted
+        mailbox.Wait();
 
         // Lock adc mutex to prevent access of other component to ADC while measuring
         bool adc_lock = fluorometer->adc_mutex->Lock(0);
@@ -27,10 +30,11 @@ void Fluorometer_thread::Run(){
         }
         Logger::Debug("Fluorometer cuvette access granted");
 
-        while(not message_buffer.empty()){
+        while(auto posted = mailbox.Front()){
 
-            auto message = message_buffer.front();
-            message_buffer.pop();
+            // Copy releases slot for dispatcher before long lasting measurement
+            auto message = *posted;
+            mailbox.Pop();
 
             auto message_type = message.Message_type();
 
@@ -66,9 +70,14 @@ void Fluorometer_thread::Run(){
                     fluorometer->OJIP_data.measurement_id = ojip_request.measurement_id;
                     fluorometer->OJIP_data.emitor_intensity = ojip_request.emitor_intensity;
 
-                    fluorometer->Capture_OJIP(ojip_request.detector_gain, ojip_request.emitor_intensity, (ojip_request.length_ms/1000.0f), ojip_request.samples, ojip_request.sample_timing);
+                    bool captured = fluorometer->Capture_OJIP(ojip_request.detector_gain, ojip_request.emitor_intensity, (ojip_request.length_ms/1000.0f), ojip_request.samples, ojip_request.sample_timing);
 
                     fluorometer->OJIP_data.detector_gain = fluorometer->Gain();
+
+                    // Parameters are extracted only from measurements, calibration capture is not described
+                    if (captured and fluorometer->OJIP_phase_5_Parameters() and fluorometer->capture_options.send_parameters) {
+                        fluorometer->Send_OJIP_parameters();
+                    }
                 } break;
 
                 case Codes::Message_type::Fluorometer_OJIP_retrieve_request: {
@@ -86,6 +95,30 @@ void Fluorometer_thread::Run(){
                     fluorometer->Export_data(&fluorometer->OJIP_data);
                 } break;
 
+                case Codes::Message_type::Fluorometer_OJIP_retrieve_packed_request: {
+                    Logger::Notice("Fluorometer OJIP packed export started");
+                    if(!fluorometer->ojip_capture_finished) {
+                        Logger::Warning("Fluorometer OJIP capture not finished");
+                        break;
+                    }
+
+                    if(fluorometer->OJIP_data.intensity.size() == 0) {
+                        Logger::Warning("Fluorometer OJIP data empty");
+                        break;
+                    }
+
+                    fluorometer->Export_data_packed(&fluorometer->OJIP_data);
+                } break;
+
+                case Codes::Message_type::Fluorometer_OJIP_bin_counts_request: {
+                    if(!fluorometer->ojip_capture_finished) {
+                        Logger::Warning("Fluorometer OJIP capture not finished");
+                        break;
+                    }
+
+                    fluorometer->Export_conversion_counts(&fluorometer->OJIP_data);
+                } break;
+
                 case Codes::Message_type::Fluorometer_calibration_request: {
                     Logger::Notice("Fluorometer calibration request");
                     fluorometer->Calibrate();
@@ -98,25 +131,19 @@ void Fluorometer_thread::Run(){
         // Unlocking mutex to allow other components to access cuvette
         fluorometer->cuvette_mutex->Unlock();
         fluorometer->adc_mutex->Unlock();
-
-        // Suspend thread until new message is enqueued
-        Suspend();
     }
 }
 
-bool Fluorometer_thread::Enqueue_message(Application_message &message){
+bool Fluorometer_thread::Enqueue_message(Application_message const &message){
     // Check if message type is supported
     if (std::find(supported_messages.begin(), supported_messages.end(), message.Message_type()) == supported_messages.end()){
         Logger::Error("Message type {} not supported", Codes::to_string(message.Message_type()));
         return false;
     }
 
-    if (message_buffer.full()){
-        Logger::Error("Spectrophotometer thread message buffer full");
+    if (not mailbox.Post(message)){
+        Logger::Error("Fluorometer thread message buffer full");
         return false;
     }
-    message_buffer.push(message);
-    // Resume thread to process message
-    Resume();
     return true;
 }
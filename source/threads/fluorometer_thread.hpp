@@ -10,7 +10,7 @@
 #include "thread.hpp"
 #include "codes/codes.hpp"
 #include "logger.hpp"
-#include "etl/queue.h"
+#include "tools/mailbox.hpp"
 #include "etl/array.h"
 #include "can_bus/app_message.hpp"
 #include "components/fluorometer.hpp"
@@ -27,23 +27,25 @@ private:
     Fluorometer * const fluorometer;
 
     /**
-     * @brief   Buffer for storing messages received from CAN bus before processing then in FIFO order
+     * @brief   Messages posted by dispatcher, processed by this thread in FIFO order
      */
-    etl::queue<Application_message, 32, etl::memory_model::MEMORY_MODEL_SMALL> message_buffer;
+    Mailbox<Application_message, 32> mailbox;
 
     /**
      * @brief   List of messages supported for processing by this thread
      */
-    const etl::array<Codes::Message_type, 3> supported_messages = {
+    const etl::array<Codes::Message_type, 5> supported_messages = {
         Codes::Message_type::Fluorometer_OJIP_capture_request,
         Codes::Message_type::Fluorometer_OJIP_retrieve_request,
+        Codes::Message_type::Fluorometer_OJIP_retrieve_packed_request,
+        Codes::Message_type::Fluorometer_OJIP_bin_counts_request,
         Codes::Message_type::Fluorometer_calibration_request,
     };
 
 public:
     explicit Fluorometer_thread(Fluorometer * const fluorometer);
 
-    bool Enqueue_message(Application_message &message);
+    bool Enqueue_message(Application_message const &message);
 
 protected:
     /**
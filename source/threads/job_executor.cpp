@@ -0,0 +1,108 @@
+#include "job_executor.hpp"
+
+#include <algorithm>
+
+#include "logger.hpp"
+
+#include "pico/time.h"
+
+void Job_executor::Init(){
+    if (lock != nullptr) {
+        return;
+    }
+
+    lock = new fra::MutexStandard();
+    pending = new fra::CountingSemaphore(max_components * queue_depth, 0);
+
+    static constexpr etl::array<const char *, worker_count> worker_names = {"job_worker_0", "job_worker_1"};
+    for (auto name : worker_names) {
+        // Priority is below dispatcher, so routing of received messages is preferred to deferred work
+        workers.push_back(new rtos::Lambda_thread(name, [](){ Worker(); }, 2048, 8));
+    }
+}
+
+bool Job_executor::Submit(Codes::Component component, Job job, std::optional<Dispatch_profiler::Origin> origin){
+    if (lock == nullptr) {
+        Logger::Error("Job executor is not initialized");
+        return false;
+    }
+
+    lock->Lock();
+
+    auto lane = std::find_if(lanes.begin(), lanes.end(), [component](Lane const &entry){
+        return entry.component == component;
+    });
+
+    if (lane == lanes.end()) {
+        if (lanes.full()) {
+            lock->Unlock();
+            Logger::Error("Job executor has no free work queue for component {}", Codes::to_string(component));
+            statistics.rejected++;
+            return false;
+        }
+        lanes.push_back(Lane{component, {}, false});
+        lane = lanes.end() - 1;
+    }
+
+    if (lane->jobs.full()) {
+        lock->Unlock();
+        Logger::Warning("Work queue of component {} is full, job rejected", Codes::to_string(component));
+        statistics.rejected++;
+        return false;
+    }
+
+    lane->jobs.push(Task{std::move(job), origin});
+    statistics.submitted++;
+    lock->Unlock();
+
+    pending->Give();
+    return true;
+}
+
+void Job_executor::Worker(){
+    while (true) {
+        pending->Take();
+
+        lock->Lock();
+        Lane * lane = Acquire_lane();
+        lock->Unlock();
+
+        // Job belongs to component which is already executed by other worker, that worker drains it
+        if (lane == nullptr) {
+            continue;
+        }
+
+        // Lane is drained completely, jobs submitted during execution are picked up too
+        while (true) {
+            lock->Lock();
+            if (lane->jobs.empty()) {
+                lane->busy = false;
+                lock->Unlock();
+                break;
+            }
+            Task task = std::move(lane->jobs.front());
+            lane->jobs.pop();
+            lock->Unlock();
+
+            uint32_t start_us = time_us_32();
+            task.job();
+            if (task.origin.has_value()) {
+                Dispatch_profiler::Record_job(task.origin.value(), start_us, time_us_32());
+            }
+            statistics.executed++;
+        }
+    }
+}
+
+Job_executor::Lane * Job_executor::Acquire_lane(){
+    for (size_t offset = 0; offset < lanes.size(); offset++) {
+        size_t index = (next_lane + offset) % lanes.size();
+        Lane &lane = lanes[index];
+        if (not lane.busy and not lane.jobs.empty()) {
+            lane.busy = true;
+            next_lane = (index + 1) % lanes.size();
+            return &lane;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file job_executor.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <stdint.h>
+
+#include "codes/codes.hpp"
+#include "can_bus/dispatch_profiler.hpp"
+
+#include "etl/array.h"
+#include "etl/queue.h"
+#include "etl/vector.h"
+
+#include "semaphore.hpp"
+#include "mutex.hpp"
+#include "rtos/lamda_thread.hpp"
+
+namespace fra = cpp_freertos;
+
+/**
+ * @brief   Executor of work deferred from message handlers, keeps dispatcher (Common_thread) free of blocking operations
+ *          Handlers of requests which wait for sensors or peripherals only enqueue job and return immediately,
+ *              job is then executed by one of worker threads and sends response itself
+ *          Every component has its own work queue, jobs of one component are executed in FIFO order and never concurrently,
+ *              so component does not need to be reentrant, jobs of different components are executed in parallel
+ *          Execution time of jobs deferred from message handlers is recorded by Dispatch_profiler under type of message
+ */
+class Job_executor {
+public:
+    /**
+     * @brief   Deferred work, captures everything it needs (usually component and copy of request data)
+     */
+    using Job = std::function<void()>;
+
+    /**
+     * @brief   Number of worker threads
+     */
+    static constexpr uint8_t worker_count = 2;
+
+    /**
+     * @brief   Maximal number of pending jobs of one component
+     */
+    static constexpr size_t queue_depth = 8;
+
+    /**
+     * @brief   Maximal number of components which can defer work
+     */
+    static constexpr size_t max_components = 8;
+
+    /**
+     * @brief   Statistics of executor
+     */
+    struct Statistics {
+        uint32_t submitted  = 0;
+        uint32_t executed   = 0;
+        uint32_t rejected   = 0;    // Jobs not accepted due to full queue of component
+    };
+
+private:
+    /**
+     * @brief   Job with message from which it was deferred
+     */
+    struct Task {
+        Job                                         job;
+        std::optional<Dispatch_profiler::Origin>    origin;     // Message which handler deferred job
+    };
+
+    /**
+     * @brief   Work queue of one component
+     */
+    struct Lane {
+        Codes::Component                component;
+        etl::queue<Task, queue_depth>   jobs;
+        bool                            busy = false;   // Job of this lane is executed by some worker
+    };
+
+    /**
+     * @brief   Work queues, created on first job of component, never removed
+     */
+    inline static etl::vector<Lane, max_components> lanes;
+
+    /**
+     * @brief   Guards lanes, jobs are executed outside of lock
+     */
+    inline static fra::MutexStandard * lock = nullptr;
+
+    /**
+     * @brief   Counts submitted jobs, workers wait on it
+     */
+    inline static fra::CountingSemaphore * pending = nullptr;
+
+    /**
+     * @brief   Worker threads
+     */
+    inline static etl::vector<rtos::Lambda_thread *, worker_count> workers;
+
+    /**
+     * @brief   Index of lane from which next search for work starts, rotates for fairness between components
+     */
+    inline static size_t next_lane = 0;
+
+    inline static Statistics statistics;
+
+public:
+    /**
+     * @brief   Create synchronization primitives and start worker threads, must be called before first job is submitted
+     */
+    static void Init();
+
+    /**
+     * @brief   Enqueue job to work queue of component
+     *
+     * @param component Component which owns the job
+     * @param job       Work to execute
+     * @param origin    Message which handler deferred job, execution time is profiled under its type
+     * @return true     Job was enqueued
+     * @return false    Work queue of component is full or executor is not initialized
+     */
+    static bool Submit(Codes::Component component, Job job, std::optional<Dispatch_profiler::Origin> origin = std::nullopt);
+
+    /**
+     * @brief   Return statistics of executor
+     */
+    static Statistics Stats() { return statistics; };
+
+private:
+    /**
+     * @brief   Main loop of worker thread
+     */
+    static void Worker();
+
+    /**
+     * @brief   Find lane with pending jobs which is not executed by other worker and mark it as busy
+     *          Must be called with lock held
+     *
+     * @return Lane*    Acquired lane, nullptr when there is no work available
+     */
+    static Lane * Acquire_lane();
+};
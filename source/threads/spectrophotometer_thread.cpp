@@ -4,12 +4,15 @@ Spectrophotometer_thread::Spectrophotometer_thread(Spectrophotometer * const spe
     Thread("spectrophotometer_thread", 2048, 7),
     spectrophotometer(spectrophotometer){
     Start();
+    mailbox.Attach(GetHandle());
 }
 
 void Spectrophotometer_thread::Run(){
     Logger::Trace("Spectrophotometer thread start");
 
     while (true) {
+        // Sleep until message is posted
+        mailbox.Wait();
 
         // Locking mutex to prevent access to cuvette while measuring
         bool lock = spectrophotometer->cuvette_mutex->Lock(0);
@@ -19,10 +22,11 @@ void Spectrophotometer_thread::Run(){
         }
         Logger::Debug("Spectrophotometer cuvette access granted");
 
-        while(not message_buffer.empty()){
+        while(auto posted = mailbox.Front()){
 
-            auto message = message_buffer.front();
-            message_buffer.pop();
+            // Copy releases slot for dispatcher before long lasting measurement
+            auto message = *posted;
+            mailbox.Pop();
 
             auto message_type = message.Message_type();
 
@@ -77,13 +81,10 @@ void Spectrophotometer_thread::Run(){
         }
         // Unlocking mutex to allow other components to access cuvette
         spectrophotometer->cuvette_mutex->Unlock();
-
-        // Suspend thread until new message is enqueued
-        Suspend();
     }
 }
 
-bool Spectrophotometer_thread::Enqueue_message(Application_message &message){
+bool Spectrophotometer_thread::Enqueue_message(Application_message const &message){
 
     // Check if message type is supported
     if (std::find(supported_messages.begin(), supported_messages.end(), message.Message_type()) == supported_messages.end()){
@@ -91,13 +92,9 @@ bool Spectrophotometer_thread::Enqueue_message(Application_message &message){
         return false;
     }
 
-    if (message_buffer.full()){
+    if (not mailbox.Post(message)){
         Logger::Error("Spectrophotometer thread message buffer full");
         return false;
     }
-
-    message_buffer.push(message);
-    // Resume thread to process message
-    Resume();
     return true;
 }
@@ -10,7 +10,7 @@
 #include "thread.hpp"
 #include "codes/codes.hpp"
 #include "logger.hpp"
-#include "etl/queue.h"
+#include "tools/mailbox.hpp"
 #include "etl/array.h"
 #include "can_bus/app_message.hpp"
 #include "components/spectrophotometer.hpp"
@@ -26,9 +26,9 @@ private:
     Spectrophotometer * const spectrophotometer;
 
     /**
-     * @brief   Buffer for storing messages received from CAN bus before processing then in FIFO order by thread
+     * @brief   Messages posted by dispatcher, processed by this thread in FIFO order
      */
-    etl::queue<Application_message, 32, etl::memory_model::MEMORY_MODEL_SMALL> message_buffer;
+    Mailbox<Application_message, 32> mailbox;
 
     /**
      * @brief   List of messages supported for processing by this thread
@@ -42,7 +42,7 @@ public:
 
     explicit Spectrophotometer_thread(Spectrophotometer * const spectrophotometer);
 
-    bool Enqueue_message(Application_message &message);
+    bool Enqueue_message(Application_message const &message);
 
 protected:
     /**
@@ -4,9 +4,12 @@
 #include "modules/base_module.hpp"
 #include "modules/sensor_module.hpp"
 #include "modules/control_module.hpp"
+#include "can_bus/bus_statistics.hpp"
+#include "config.hpp"
 
 #include "components/led/led_pwm.hpp"
 #include "components/led_panel.hpp"
+#include "components/fluorometer.hpp"
 #include "components/fan/fan_gpio.hpp"
 #include "components/fan/fan_pwm.hpp"
 #include "components/fan/fan_rpm.hpp"
@@ -29,6 +32,9 @@
 #include "logger.hpp"
 #include "emio/emio.hpp"
 
+#include <unordered_map>
+#include "etl/unordered_map.h"
+
 Test_thread::Test_thread(CAN_thread *can_thread)
     : Thread("test_thread", 4096, 10),
     can_thread(can_thread){
@@ -47,6 +53,8 @@ void Test_thread::Run(){
     // Calibrate_VEML_lux(*i2c);
     // Spectrophotometer_test(*i2c);
     // LED_test(*i2c);
+    // Routing_benchmark();
+    // Calibration_alignment_benchmark();
 
     Multi_OJIP();
 };
@@ -764,3 +772,105 @@ void Test_thread::Pacing_timestamp_nonlinear_test(){
         Logger::Debug("Sample {:3d}: {:5d}", (int)i, (int)timestamp_buffer[i]);
     }
 }  // Test_thread::Pacing_timestamp_nonlinear_test
+
+void Test_thread::Routing_benchmark(){
+    const uint32_t rounds = 200;
+    const uint32_t lookups = rounds * Routing_table.size();
+    volatile uintptr_t sink = 0;
+
+    // Legacy routing structures, bypass map, hash map routing table and map of component instances
+    etl::unordered_map<Codes::Message_type, Codes::Component, 32> legacy_bypass;
+    std::unordered_map<Codes::Message_type, Codes::Component> legacy_table;
+    etl::unordered_map<Codes::Component, uintptr_t, 32> legacy_instances;
+    for (auto const &record : Routing_table) {
+        legacy_table.insert({record.message_type, record.component});
+        if (not legacy_instances.full()) {
+            legacy_instances.insert({record.component, static_cast<uintptr_t>(record.component)});
+        }
+    }
+
+    uint32_t start = time_us_32();
+    for (uint32_t round = 0; round < rounds; round++) {
+        for (auto const &record : Routing_table) {
+            if (legacy_bypass.find(record.message_type) != legacy_bypass.end()) {
+                continue;
+            }
+            auto receiver = legacy_table.find(record.message_type);
+            if (receiver != legacy_table.end()) {
+                sink = sink + legacy_instances[receiver->second];
+            }
+        }
+    }
+    uint32_t legacy_time = time_us_32() - start;
+
+    start = time_us_32();
+    for (uint32_t round = 0; round < rounds; round++) {
+        for (auto const &record : Routing_table) {
+            bool bypass;
+            sink = sink + reinterpret_cast<uintptr_t>(Message_router::Resolve(record.message_type, bypass));
+        }
+    }
+    uint32_t flat_time = time_us_32() - start;
+
+    Logger::Notice("Routing benchmark: {} lookups", lookups);
+    Logger::Notice("Hash map routing: {} us total, {} ns per frame", legacy_time, legacy_time * 1000 / lookups);
+    Logger::Notice("Flat table routing: {} us total, {} ns per frame", flat_time, flat_time * 1000 / lookups);
+}
+
+void Test_thread::Calibration_alignment_benchmark(){
+    const size_t samples = FLUOROMETER_MAX_SAMPLES;
+    volatile size_t sink = 0;
+
+    // Quadratic spacing resembles logarithmic OJIP timing, dense at start of capture
+    static std::array<uint32_t, FLUOROMETER_CALIBRATION_SAMPLES> calibration_timing;
+    for (size_t i = 0; i < calibration_timing.size(); i++) {
+        calibration_timing[i] = 2 * i * i;
+    }
+    static etl::vector<uint32_t, FLUOROMETER_MAX_SAMPLES> sample_timing;
+    sample_timing.clear();
+    for (size_t i = 0; i < samples; i++) {
+        sample_timing.push_back((i * i) / 8);
+    }
+
+    // Legacy alignment, calibration passed by value and binary searched for every sample
+    auto legacy_closest = [](std::array<uint32_t, FLUOROMETER_CALIBRATION_SAMPLES> calibration, uint32_t target_time_us) -> size_t {
+        auto it = std::lower_bound(calibration.begin(), calibration.end(), target_time_us);
+        if (it == calibration.begin()) {
+            return 0;
+        }
+        if (it == calibration.end()) {
+            return calibration.size() - 1;
+        }
+        size_t index_before = std::distance(calibration.begin(), it - 1);
+        return ((target_time_us - *(it - 1)) < (*it - target_time_us)) ? index_before : index_before + 1;
+    };
+
+    uint32_t start = time_us_32();
+    for (size_t i = 0; i < samples; i++) {
+        sink = sink + legacy_closest(calibration_timing, sample_timing[i]);
+    }
+    uint32_t legacy_time = time_us_32() - start;
+
+    size_t mismatches = 0;
+    start = time_us_32();
+    Fluorometer::Calibration_cursor cursor(calibration_timing);
+    for (size_t i = 0; i < samples; i++) {
+        sink = sink + cursor.Closest(sample_timing[i]);
+    }
+    uint32_t cursor_time = time_us_32() - start;
+
+    Fluorometer::Calibration_cursor check(calibration_timing);
+    for (size_t i = 0; i < samples; i++) {
+        if (check.Closest(sample_timing[i]) != legacy_closest(calibration_timing, sample_timing[i])) {
+            mismatches++;
+        }
+    }
+
+    // Every exported sample occupies one data frame on bus
+    uint32_t bus_time = static_cast<uint64_t>(samples) * CAN::Bus_statistics::Frame_bits(8, true) * 1'000'000 / CONFIG_CANBUS_SPEED;
+
+    Logger::Notice("Calibration alignment benchmark: {} samples, {} calibration points", samples, calibration_timing.size());
+    Logger::Notice("Binary search with copy: {} us total, {} ns per sample", legacy_time, legacy_time * 1000 / samples);
+    Logger::Notice("Merge-walk cursor: {} us total, {} ns per sample", cursor_time, cursor_time * 1000 / samples);
+    Logger::Notice("Transmission of export on bus: {} us, mismatches: {}", bus_time, mismatches);
+}
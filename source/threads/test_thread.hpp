@@ -100,5 +100,9 @@ private:
 
     void Calibrate_VEML_lux(I2C_bus &i2c);
 
+    void Routing_benchmark();
+
+    void Calibration_alignment_benchmark();
+
 };
 
@@ -0,0 +1,114 @@
+/**
+ * @file mailbox.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#include "tools/spsc_ring.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief   Mailbox of worker thread, single producer (usually dispatcher) posts items which are processed by single consumer thread
+ *          Items are stored in lock-free SPSC ring, consumer is woken by task notification
+ *          Notification is counting, so post which happens between check of ring and wait of consumer is not lost
+ *
+ * @tparam T    Type of posted item, must be default constructible
+ * @tparam N    Capacity of mailbox, must be power of two
+ */
+template <typename T, uint32_t N>
+class Mailbox {
+private:
+    /**
+     * @brief   Storage of posted items
+     */
+    SPSC_ring<T, N> ring;
+
+    /**
+     * @brief   Thread which consumes items, notified on every post
+     */
+    std::atomic<TaskHandle_t> consumer = nullptr;
+
+public:
+    /**
+     * @brief   Set thread which consumes items, must be called before first item is posted
+     *
+     * @param task  Handle of consumer thread
+     */
+    void Attach(TaskHandle_t task){
+        consumer.store(task, std::memory_order_release);
+    }
+
+    /**
+     * @brief   Producer side, copy item into mailbox and wake consumer
+     *
+     * @param item      Item to post
+     * @return true     Item was posted
+     * @return false    Mailbox is full, item was discarded
+     */
+    bool Post(T const &item){
+        if (not ring.Push(item)) {
+            return false;
+        }
+
+        TaskHandle_t task = consumer.load(std::memory_order_acquire);
+        if (task != nullptr) {
+            xTaskNotifyGive(task);
+        }
+        return true;
+    }
+
+    /**
+     * @brief   Consumer side, wait until mailbox contains any item
+     *
+     * @param timeout   Maximal time to wait in ticks
+     * @return true     Mailbox contains item
+     * @return false    Timeout elapsed and mailbox is still empty
+     */
+    bool Wait(TickType_t timeout = portMAX_DELAY){
+        while (ring.Empty()) {
+            // Notifications of already consumed items can be pending, loop until item is really available
+            if (ulTaskNotifyTake(pdTRUE, timeout) == 0) {
+                return not ring.Empty();
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief   Consumer side, oldest item in mailbox, item stays valid until Pop is called
+     *
+     * @return T const*     Pointer to oldest item, nullptr if mailbox is empty
+     */
+    T const * Front() const {
+        return ring.Front();
+    }
+
+    /**
+     * @brief   Consumer side, release oldest item
+     */
+    void Pop(){
+        ring.Pop();
+    }
+
+    /**
+     * @brief   Number of items waiting in mailbox
+     */
+    uint32_t Size() const {
+        return ring.Size();
+    }
+
+    /**
+     * @brief   Check if mailbox is empty
+     */
+    bool Empty() const {
+        return ring.Empty();
+    }
+};
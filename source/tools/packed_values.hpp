@@ -0,0 +1,101 @@
+/**
+ * @file packed_values.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include <bit>
+#include <optional>
+#include <span>
+#include <stdint.h>
+
+#include "etl/vector.h"
+
+/**
+ * @brief   Batch of setpoints carried in single CAN frame
+ *          Frame data: [0] bitmask of channels (bit 0 is first channel), [1-7] 12-bit values packed big-endian one after other
+ *          Values are ordered by channel number and present only for channels which have bit set in mask,
+ *              so up to 4 channels can be set by one frame
+ */
+class Packed_values {
+public:
+    /**
+     * @brief   Maximal number of values in one frame, 7 data bytes contains four 12-bit values
+     */
+    static constexpr uint8_t max_values = 4;
+
+    /**
+     * @brief   Maximal unsigned value of 12-bit field
+     */
+    static constexpr uint16_t unsigned_max = 0x0fff;
+
+    /**
+     * @brief   Maximal positive value of signed (two's complement) 12-bit field
+     */
+    static constexpr int16_t signed_max = 0x07ff;
+
+    /**
+     * @brief   Channel and raw value of one setpoint
+     */
+    struct Entry {
+        uint8_t  channel;
+        uint16_t raw;
+    };
+
+    /**
+     * @brief   Decode frame data into list of setpoints
+     *
+     * @param data  Data of received frame
+     * @return std::optional<etl::vector<Entry, max_values>>    Setpoints ordered by channel, empty if mask does not match data length
+     */
+    static std::optional<etl::vector<Entry, max_values>> Unpack(std::span<const uint8_t> data){
+        if (data.empty()) {
+            return std::nullopt;
+        }
+
+        uint8_t mask = data[0];
+        uint8_t count = std::popcount(mask);
+        if ((count == 0) or (count > max_values) or (data.size() < 1 + Bytes(count))) {
+            return std::nullopt;
+        }
+
+        etl::vector<Entry, max_values> entries;
+        size_t bit = 0;
+        for (uint8_t channel = 0; channel < 8; channel++) {
+            if (not (mask & (1 << channel))) {
+                continue;
+            }
+            size_t byte = 1 + bit / 8;
+            uint16_t raw;
+            if (bit % 8 == 0) {
+                raw = (data[byte] << 4) | (data[byte + 1] >> 4);
+            } else {
+                raw = ((data[byte] & 0x0f) << 8) | data[byte + 1];
+            }
+            entries.push_back({channel, raw});
+            bit += 12;
+        }
+        return entries;
+    }
+
+    /**
+     * @brief   Interpret raw value as signed two's complement 12-bit number
+     *
+     * @param raw       Raw 12-bit value
+     * @return int16_t  Sign extended value
+     */
+    static constexpr int16_t Signed(uint16_t raw){
+        return (raw & 0x0800) ? static_cast<int16_t>(raw | 0xf000) : static_cast<int16_t>(raw);
+    }
+
+private:
+    /**
+     * @brief   Number of bytes occupied by given number of packed values
+     */
+    static constexpr size_t Bytes(uint8_t count){
+        return (count * 12 + 7) / 8;
+    }
+};
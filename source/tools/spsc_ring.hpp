@@ -0,0 +1,123 @@
+/**
+ * @file spsc_ring.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 16.10.2026
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * @brief   Lock-free ring buffer for single producer and single consumer (for example ISR and thread)
+ *          Items are pre-allocated and are written and read in place, producer reserves slot, fills it and commits it,
+ *              consumer reads oldest item via reference and releases it after processing
+ *          Only plain loads and stores of indexes are used, so it is usable also on Cortex-M0+ without exclusive access instructions
+ *
+ * @tparam T    Type of stored item, must be default constructible
+ * @tparam N    Capacity of ring, must be power of two
+ */
+template <typename T, uint32_t N>
+class SPSC_ring {
+    static_assert((N != 0) and ((N & (N - 1)) == 0), "Capacity of SPSC ring must be power of two");
+
+private:
+    /**
+     * @brief Storage of items
+     */
+    std::array<T, N> buffer = {};
+
+    /**
+     * @brief Number of items committed by producer, modified only by producer
+     */
+    std::atomic<uint32_t> head = 0;
+
+    /**
+     * @brief Number of items released by consumer, modified only by consumer
+     */
+    std::atomic<uint32_t> tail = 0;
+
+public:
+    /**
+     * @brief   Producer side, get slot for new item, slot is not visible to consumer until Commit is called
+     *
+     * @return T*   Pointer to free slot, nullptr if ring is full
+     */
+    T * Reserve(){
+        uint32_t current_head = head.load(std::memory_order_relaxed);
+        if ((current_head - tail.load(std::memory_order_acquire)) >= N) {
+            return nullptr;
+        }
+        return &buffer[current_head & (N - 1)];
+    }
+
+    /**
+     * @brief   Producer side, publish slot obtained by Reserve to consumer
+     */
+    void Commit(){
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief   Producer side, copy item into ring
+     *
+     * @param item      Item to store
+     * @return true     Item was stored
+     * @return false    Ring is full, item was discarded
+     */
+    bool Push(T const &item){
+        T * slot = Reserve();
+        if (slot == nullptr) {
+            return false;
+        }
+        *slot = item;
+        Commit();
+        return true;
+    }
+
+    /**
+     * @brief   Consumer side, oldest item in ring, item stays valid until Pop is called
+     *
+     * @return T const*     Pointer to oldest item, nullptr if ring is empty
+     */
+    T const * Front() const {
+        uint32_t current_tail = tail.load(std::memory_order_relaxed);
+        if (current_tail == head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &buffer[current_tail & (N - 1)];
+    }
+
+    /**
+     * @brief   Consumer side, release oldest item so slot can be reused by producer
+     */
+    void Pop(){
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief   Number of items waiting in ring
+     *
+     * @return uint32_t Number of items
+     */
+    uint32_t Size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief   Check if ring contains any item
+     */
+    bool Empty() const {
+        return Size() == 0;
+    }
+
+    /**
+     * @brief   Capacity of ring
+     */
+    static constexpr uint32_t Capacity(){
+        return N;
+    }
+};